@@ -71,6 +71,13 @@ void TFT_eSPI::loadFont(String fontName, bool flash)
        a zero/one terminated character string giving the font name
        last byte is 0 for non-anti-aliased and 1 for anti-aliased (smoothed)
 
+    Compact fonts made by Tools/Compress_Smooth_Font have version 0x52 (SMOOTH_RLE_VERSION),
+    the 7th glyph value is the bitmap offset from the start of the bitmaps and each bitmap
+    row is a series of run bytes: upper 4 bits alpha (0-15), lower 4 bits run length - 1.
+    The 4th header value is the number of kerning pairs, each pair is 2 values (left code
+    << 16 | right code, then the signed x adjustment) placed between the glyph metrics
+    and the bitmaps.
+
 
     Glyph bitmap example is:
     // Cursor coordinate positions for this and next character are marked by 'C'
@@ -116,6 +123,11 @@ void TFT_eSPI::loadFont(String fontName, bool flash)
     if(!fontFile) return;
 
     fontFile.seek(0, fs::SeekSet);
+
+    // Header and metrics are read sequentially, so read them in blocks
+    fontBuf = (uint8_t*)malloc(SMOOTH_READ_BUFFER);
+    fontBufLen = 0;
+    fontBufPos = 0;
   }
 #else
   // Avoid unused varaible warning
@@ -126,11 +138,12 @@ void TFT_eSPI::loadFont(String fontName, bool flash)
   gFont.gArray   = (const uint8_t*)fontPtr;
 
   gFont.gCount   = (uint16_t)readInt32(); // glyph count in file
-                             readInt32(); // vlw encoder version - discard
+  gFont.compact  = (readInt32() == SMOOTH_RLE_VERSION); // vlw encoder version
   gFont.yAdvance = (uint16_t)readInt32(); // Font size in points, not pixels
-                             readInt32(); // discard
+  uint32_t kerns =           readInt32(); // mboxY - discard, number of kerning pairs in a compact font
   gFont.ascent   = (uint16_t)readInt32(); // top of "d"
   gFont.descent  = (uint16_t)readInt32(); // bottom of "p"
+  gFont.kCount   = gFont.compact ? kerns : 0;
 
   // These next gFont values might be updated when the Metrics are fetched
   gFont.maxAscent  = gFont.ascent;   // Determined from metrics
@@ -142,6 +155,15 @@ void TFT_eSPI::loadFont(String fontName, bool flash)
 
   // Fetch the metrics for each glyph
   loadMetrics();
+
+#ifdef FONT_FS_AVAILABLE
+  // Glyph bitmaps are read with seeks so the read-ahead buffer is no longer needed
+  if (fontBuf)
+  {
+    free(fontBuf);
+    fontBuf = nullptr;
+  }
+#endif
 }
 
 
@@ -155,28 +177,19 @@ void TFT_eSPI::loadMetrics(void)
   uint32_t headerPtr = 24;
   uint32_t bitmapPtr = headerPtr + gFont.gCount * 28;
 
+  // One arena for all the glyph metrics, the arrays are mapped by mapMetrics()
+  uint32_t arenaSize = gFont.gCount * (4 + 2 + 2 + 1 + 1 + 1 + 1) + (SMOOTH_ASCII_INDEX + gFont.gCount) * 2
+                     + gFont.kCount * (4 + 1);
+
 #if defined (ESP32) && defined (CONFIG_SPIRAM_SUPPORT)
-  if ( psramFound() )
-  {
-    gUnicode  = (uint16_t*)ps_malloc( gFont.gCount * 2); // Unicode 16 bit Basic Multilingual Plane (0-FFFF)
-    gHeight   =  (uint8_t*)ps_malloc( gFont.gCount );    // Height of glyph
-    gWidth    =  (uint8_t*)ps_malloc( gFont.gCount );    // Width of glyph
-    gxAdvance =  (uint8_t*)ps_malloc( gFont.gCount );    // xAdvance - to move x cursor
-    gdY       =  (int16_t*)ps_malloc( gFont.gCount * 2); // offset from bitmap top edge from lowest point in any character
-    gdX       =   (int8_t*)ps_malloc( gFont.gCount );    // offset for bitmap left edge relative to cursor X
-    gBitmap   = (uint32_t*)ps_malloc( gFont.gCount * 4); // seek pointer to glyph bitmap in the file
-  }
+  if ( psramFound() ) gArena = (uint8_t*)ps_malloc(arenaSize);
   else
 #endif
-  {
-    gUnicode  = (uint16_t*)malloc( gFont.gCount * 2); // Unicode 16 bit Basic Multilingual Plane (0-FFFF)
-    gHeight   =  (uint8_t*)malloc( gFont.gCount );    // Height of glyph
-    gWidth    =  (uint8_t*)malloc( gFont.gCount );    // Width of glyph
-    gxAdvance =  (uint8_t*)malloc( gFont.gCount );    // xAdvance - to move x cursor
-    gdY       =  (int16_t*)malloc( gFont.gCount * 2); // offset from bitmap top edge from lowest point in any character
-    gdX       =   (int8_t*)malloc( gFont.gCount );    // offset for bitmap left edge relative to cursor X
-    gBitmap   = (uint32_t*)malloc( gFont.gCount * 4); // seek pointer to glyph bitmap in the file
-  }
+  gArena = (uint8_t*)malloc(arenaSize);
+
+  if (gArena == NULL) { gFont.gCount = 0; gFont.kCount = 0; } // No glyphs will be found
+
+  mapMetrics();
 
 #ifdef SHOW_ASCENT_DESCENT
   Serial.print("ascent  = "); Serial.println(gFont.ascent);
@@ -184,7 +197,12 @@ void TFT_eSPI::loadMetrics(void)
 #endif
 
 #ifdef FONT_FS_AVAILABLE
-  if (fs_font) fontFile.seek(headerPtr, fs::SeekSet);
+  if (fs_font)
+  {
+    fontFile.seek(headerPtr, fs::SeekSet);
+    fontBufLen = 0; // Discard read-ahead
+    fontBufPos = 0;
+  }
 #endif
 
   uint16_t gNum = 0;
@@ -197,7 +215,7 @@ void TFT_eSPI::loadMetrics(void)
     gxAdvance[gNum] =  (uint8_t)readInt32(); // xAdvance - to move x cursor
     gdY[gNum]       =  (int16_t)readInt32(); // y delta from baseline
     gdX[gNum]       =   (int8_t)readInt32(); // x delta from cursor
-    readInt32(); // ignored
+    uint32_t bitmapOffset = readInt32(); // padding in a vlw file, bitmap offset in a compact font
 
     //Serial.print("Unicode = 0x"); Serial.print(gUnicode[gNum], HEX); Serial.print(", gHeight  = "); Serial.println(gHeight[gNum]);
     //Serial.print("Unicode = 0x"); Serial.print(gUnicode[gNum], HEX); Serial.print(", gWidth  = "); Serial.println(gWidth[gNum]);
@@ -234,9 +252,13 @@ void TFT_eSPI::loadMetrics(void)
       }
     }
 
-    gBitmap[gNum] = bitmapPtr;
+    if (gFont.compact) gBitmap[gNum] = headerPtr + gFont.gCount * 28 + gFont.kCount * 8 + bitmapOffset;
+    else
+    {
+      gBitmap[gNum] = bitmapPtr;
 
-    bitmapPtr += gWidth[gNum] * gHeight[gNum];
+      bitmapPtr += gWidth[gNum] * gHeight[gNum];
+    }
 
     gNum++;
     yield();
@@ -245,67 +267,365 @@ void TFT_eSPI::loadMetrics(void)
   gFont.yAdvance = gFont.maxAscent + gFont.maxDescent;
 
   gFont.spaceWidth = (gFont.ascent + gFont.descent) * 2/7;  // Guess at space width
+
+  // Kerning pairs follow the metrics, insertion sort in case they are not in order
+  for (uint16_t i = 0; i < gFont.kCount; i++)
+  {
+    uint32_t pair = readInt32();
+    int8_t   adj  = (int8_t)readInt32();
+    uint16_t j = i;
+
+    while (j > 0 && gKern[j - 1] > pair)
+    {
+      gKern[j]    = gKern[j - 1];
+      gKernAdj[j] = gKernAdj[j - 1];
+      j--;
+    }
+    gKern[j]    = pair;
+    gKernAdj[j] = adj;
+  }
+
+  kernCode = 0;
+
+  buildIndex();
 }
 
 
 /***************************************************************************************
-** Function name:           deleteMetrics
-** Description:             Delete the old glyph metrics and free up the memory
+** Function name:           mapMetrics
+** Description:             Point the glyph metric arrays into the metrics arena
 *************************************************************************************x*/
-void TFT_eSPI::unloadFont( void )
+void TFT_eSPI::mapMetrics(void)
 {
-  if (gUnicode)
+  if (gArena == NULL)
   {
-    free(gUnicode);
-    gUnicode = NULL;
+    gBitmap = NULL; gUnicode = NULL; gdY = NULL; gIndex = NULL;
+    gHeight = NULL; gWidth = NULL; gxAdvance = NULL; gdX = NULL;
+    gKern = NULL; gKernAdj = NULL;
+    return;
   }
 
-  if (gHeight)
+  uint16_t n = gFont.gCount;
+  uint16_t k = gFont.kCount;
+
+  // Largest types first so every array is aligned
+  gBitmap   = (uint32_t*)gArena;                   // seek pointer to glyph bitmap in the file
+  gKern     = gBitmap + n;                         // kerning pairs
+  gUnicode  = (uint16_t*)(gKern + k);              // Unicode 16 bit Basic Multilingual Plane (0-FFFF)
+  gdY       =  (int16_t*)(gUnicode + n);           // offset from bitmap top edge from lowest point in any character
+  gIndex    = (uint16_t*)(gdY + n);                // glyph lookup index
+  gHeight   =  (uint8_t*)(gIndex + SMOOTH_ASCII_INDEX + n); // Height of glyph
+  gWidth    =  gHeight + n;                        // Width of glyph
+  gxAdvance =  gWidth + n;                         // xAdvance - to move x cursor
+  gdX       =   (int8_t*)(gxAdvance + n);          // offset for bitmap left edge relative to cursor X
+  gKernAdj  =   gdX + n;                           // kerning pair x adjustment
+}
+
+
+/***************************************************************************************
+** Function name:           decodeGlyph
+** Description:             Expand a compact font glyph to 8 bit alpha values
+*************************************************************************************x*/
+// alpha must have room for gWidth[gNum] * gHeight[gNum] bytes
+void TFT_eSPI::decodeGlyph(uint16_t gNum, uint8_t* alpha)
+{
+  uint32_t count = gWidth[gNum] * gHeight[gNum];
+  const uint8_t* ptr = gFont.gArray + gBitmap[gNum];
+
+#ifdef FONT_FS_AVAILABLE
+  uint8_t chunk[64]; // Runs are read from a file in small blocks
+  uint8_t len = 0;
+  uint8_t pos = 0;
+  if (fs_font) fontFile.seek(gBitmap[gNum], fs::SeekSet);
+#endif
+
+  while (count)
   {
-    free(gHeight);
-    gHeight = NULL;
+    uint8_t code;
+#ifdef FONT_FS_AVAILABLE
+    if (fs_font)
+    {
+      if (pos >= len)
+      {
+        len = fontFile.read(chunk, sizeof(chunk));
+        pos = 0;
+        if (len == 0) break;
+      }
+      code = chunk[pos++];
+    }
+    else
+#endif
+    code = pgm_read_byte(ptr++);
+
+    uint32_t run = (code & 0x0F) + 1;
+    if (run > count) run = count;
+    memset(alpha, (code >> 4) * 17, run); // 4 bit to 8 bit alpha
+    alpha += run;
+    count -= run;
   }
 
-  if (gWidth)
+  if (count) memset(alpha, 0, count); // Truncated file
+}
+
+
+/***************************************************************************************
+** Function name:           buildIndex
+** Description:             Build the glyph lookup index used by getUnicodeIndex
+*************************************************************************************x*/
+void TFT_eSPI::buildIndex(void)
+{
+  if (gIndex == NULL) return; // The metrics could not be allocated, the font has no glyphs
+
+  uint16_t* ascii  = gIndex;
+  uint16_t* sorted = gIndex + SMOOTH_ASCII_INDEX;
+
+  for (uint16_t i = 0; i < SMOOTH_ASCII_INDEX; i++) ascii[i] = SMOOTH_NO_GLYPH;
+
+  // Insertion sort of glyph numbers by Unicode value. The Processing font creator
+  // writes glyphs in ascending order so this is normally a single linear pass.
+  // The sort is stable so the first of any duplicated codes is found, as before.
+  for (uint16_t i = 0; i < gFont.gCount; i++)
   {
-    free(gWidth);
-    gWidth = NULL;
+    uint16_t code = gUnicode[i];
+    uint16_t j = i;
+
+    while (j > 0 && gUnicode[sorted[j - 1]] > code)
+    {
+      sorted[j] = sorted[j - 1];
+      j--;
+    }
+    sorted[j] = i;
+
+    if (code < SMOOTH_ASCII_INDEX && ascii[code] == SMOOTH_NO_GLYPH) ascii[code] = i;
   }
+}
+
 
-  if (gxAdvance)
+/***************************************************************************************
+** Function name:           deleteMetrics
+** Description:             Delete the old glyph metrics and free up the memory
+*************************************************************************************x*/
+void TFT_eSPI::unloadFont( void )
+{
+  if (gArena)
   {
-    free(gxAdvance);
-    gxAdvance = NULL;
+    flushTextWidthCache(gArena); // A new font may reuse the address
+    free(gArena);
+    gArena = NULL;
   }
+  mapMetrics();
 
-  if (gdY)
+  gFont.gArray = nullptr;
+
+#ifdef FONT_FS_AVAILABLE
+  if (fontBuf)
   {
-    free(gdY);
-    gdY = NULL;
+    free(fontBuf);
+    fontBuf = nullptr;
   }
+  flushGlyphCache();
+  if (fs_font && fontFile) fontFile.close();
+#endif
 
-  if (gdX)
+  fontLoaded = false;
+}
+
+
+/***************************************************************************************
+** Function name:           selectFont
+** Description:             Select a resident font, the current font stays loaded
+*************************************************************************************x*/
+void TFT_eSPI::selectFont(uint8_t handle)
+{
+  if ((handle >= SMOOTH_FONT_SLOTS) || (handle == fontHandle)) return;
+
+  // Park the selected font
+  fontSlot* slot = &fontSlots[fontHandle];
+
+  slot->gFont      = gFont;
+  slot->gArena     = gArena;
+  slot->fontLoaded = fontLoaded;
+#ifdef FONT_FS_AVAILABLE
+  slot->fontFile   = fontFile;
+  slot->spiffs     = spiffs;
+  slot->fs_font    = fs_font;
+  slot->glyphCache = glyphCache;
+  slot->glyphCacheUsed = glyphCacheUsed;
+#endif
+
+  // Restore the new font, nothing is read from the font file or array
+  fontHandle = handle;
+  slot = &fontSlots[fontHandle];
+
+  gFont      = slot->gFont;
+  gArena     = slot->gArena;
+  fontLoaded = slot->fontLoaded;
+  mapMetrics();
+  kernCode   = 0; // Do not kern across fonts
+#ifdef FONT_FS_AVAILABLE
+  fontFile   = slot->fontFile;
+  spiffs     = slot->spiffs;
+  fs_font    = slot->fs_font;
+  glyphCache = slot->glyphCache;
+  glyphCacheUsed = slot->glyphCacheUsed;
+  slot->fontFile = fs::File(); // Only the selected font holds the file open
+#endif
+  slot->gArena = NULL;
+}
+
+
+/***************************************************************************************
+** Function name:           unloadAllFonts
+** Description:             Unload the fonts in all handles and free their memory
+*************************************************************************************x*/
+// Parked fonts keep their metrics, cached glyphs and open file until they are unloaded
+void TFT_eSPI::unloadAllFonts(void)
+{
+  uint8_t handle = fontHandle;
+
+  for (uint8_t i = 0; i < SMOOTH_FONT_SLOTS; i++)
   {
-    free(gdX);
-    gdX = NULL;
+    selectFont(i);
+    if (fontLoaded) unloadFont();
   }
 
-  if (gBitmap)
+  selectFont(handle);
+}
+
+
+/***************************************************************************************
+** Function name:           getFontHandle
+** Description:             Return the selected font handle
+*************************************************************************************x*/
+uint8_t TFT_eSPI::getFontHandle(void)
+{
+  return fontHandle;
+}
+
+
+#ifdef FONT_FS_AVAILABLE
+/***************************************************************************************
+** Function name:           setGlyphCacheSize
+** Description:             Set the maximum RAM used to cache font file glyph bitmaps
+*************************************************************************************x*/
+void TFT_eSPI::setGlyphCacheSize(uint32_t bytes)
+{
+  glyphCacheSize = bytes;
+  while (glyphCacheUsed > glyphCacheSize) evictGlyph();
+}
+
+
+/***************************************************************************************
+** Function name:           getGlyphCacheStats
+** Description:             Get the glyph cache hit and miss counts, optionally reset them
+*************************************************************************************x*/
+void TFT_eSPI::getGlyphCacheStats(uint32_t *hits, uint32_t *misses, bool reset)
+{
+  if (hits)   *hits   = glyphCacheHits;
+  if (misses) *misses = glyphCacheMisses;
+  if (reset) { glyphCacheHits = 0; glyphCacheMisses = 0; }
+}
+
+
+/***************************************************************************************
+** Function name:           getCachedGlyph
+** Description:             Get a glyph bitmap from the cache, reading the file on a miss
+*************************************************************************************x*/
+// Returns nullptr if the glyph cannot be cached, the caller must then read the file
+const uint8_t* TFT_eSPI::getCachedGlyph(uint16_t gNum)
+{
+  uint32_t size = sizeof(glyphCacheEntry) + gWidth[gNum] * gHeight[gNum];
+  if (size > glyphCacheSize) return nullptr;
+
+  glyphCacheEntry* prev  = nullptr;
+  glyphCacheEntry* entry = glyphCache;
+
+  while (entry)
   {
-    free(gBitmap);
-    gBitmap = NULL;
+    if (entry->gNum == gNum)
+    {
+      // Move to the front of the list so it is the last to be evicted
+      if (prev)
+      {
+        prev->next  = entry->next;
+        entry->next = glyphCache;
+        glyphCache  = entry;
+      }
+      glyphCacheHits++;
+      return (const uint8_t*)(entry + 1);
+    }
+    prev  = entry;
+    entry = entry->next;
   }
 
-  gFont.gArray = nullptr;
+  glyphCacheMisses++;
 
-#ifdef FONT_FS_AVAILABLE
-  if (fs_font && fontFile) fontFile.close();
+  while (glyphCacheUsed + size > glyphCacheSize) evictGlyph();
+
+#if defined (ESP32) && defined (CONFIG_SPIRAM_SUPPORT)
+  if ( psramFound() ) entry = (glyphCacheEntry*)ps_malloc(size);
+  else
 #endif
+  entry = (glyphCacheEntry*)malloc(size);
 
-  fontLoaded = false;
+  if (entry == nullptr) return nullptr;
+
+  // One seek and one read for the whole bitmap
+  uint32_t bytes = size - sizeof(glyphCacheEntry);
+  if (gFont.compact) decodeGlyph(gNum, (uint8_t*)(entry + 1));
+  else
+  {
+    fontFile.seek(gBitmap[gNum], fs::SeekSet);
+    if (fontFile.read((uint8_t*)(entry + 1), bytes) != bytes)
+    {
+      free(entry);
+      return nullptr;
+    }
+  }
+
+  entry->gNum  = gNum;
+  entry->next  = glyphCache;
+  glyphCache   = entry;
+  glyphCacheUsed += size;
+
+  return (const uint8_t*)(entry + 1);
+}
+
+
+/***************************************************************************************
+** Function name:           evictGlyph
+** Description:             Remove the least recently used glyph from the cache
+*************************************************************************************x*/
+void TFT_eSPI::evictGlyph(void)
+{
+  if (glyphCache == nullptr) { glyphCacheUsed = 0; return; }
+
+  glyphCacheEntry** last = &glyphCache;
+  while ((*last)->next) last = &(*last)->next;
+
+  glyphCacheUsed -= sizeof(glyphCacheEntry) + gWidth[(*last)->gNum] * gHeight[(*last)->gNum];
+  free(*last);
+  *last = nullptr;
 }
 
 
+/***************************************************************************************
+** Function name:           flushGlyphCache
+** Description:             Free all cached glyph bitmaps
+*************************************************************************************x*/
+void TFT_eSPI::flushGlyphCache(void)
+{
+  while (glyphCache)
+  {
+    glyphCacheEntry* next = glyphCache->next;
+    free(glyphCache);
+    glyphCache = next;
+  }
+  glyphCacheUsed = 0;
+}
+#endif
+
+
 /***************************************************************************************
 ** Function name:           readInt32
 ** Description:             Get a 32 bit integer from the font file
@@ -315,7 +635,19 @@ uint32_t TFT_eSPI::readInt32(void)
   uint32_t val = 0;
 
 #ifdef FONT_FS_AVAILABLE
-  if (fs_font) {
+  if (fs_font && fontBuf) {
+    for (uint8_t i = 0; i < 4; i++)
+    {
+      if (fontBufPos >= fontBufLen)
+      {
+        fontBufLen = fontFile.read(fontBuf, SMOOTH_READ_BUFFER);
+        fontBufPos = 0;
+        if (fontBufLen == 0) break;
+      }
+      val = val << 8 | fontBuf[fontBufPos++];
+    }
+  }
+  else if (fs_font) {
     val |= fontFile.read() << 24;
     val |= fontFile.read() << 16;
     val |= fontFile.read() << 8;
@@ -340,18 +672,60 @@ uint32_t TFT_eSPI::readInt32(void)
 *************************************************************************************x*/
 bool TFT_eSPI::getUnicodeIndex(uint16_t unicode, uint16_t *index)
 {
-  for (uint16_t i = 0; i < gFont.gCount; i++)
+  if (gIndex == NULL) return false; // No font, or the metrics could not be allocated
+
+  // Direct table lookup for ASCII
+  if (unicode < SMOOTH_ASCII_INDEX)
   {
-    if (gUnicode[i] == unicode)
-    {
-      *index = i;
-      return true;
-    }
+    *index = gIndex[unicode];
+    return (*index != SMOOTH_NO_GLYPH);
+  }
+
+  // Binary search of the sorted glyph numbers for all other codes
+  uint16_t* sorted = gIndex + SMOOTH_ASCII_INDEX;
+  uint16_t lo = 0;
+  uint16_t hi = gFont.gCount;
+
+  while (lo < hi)
+  {
+    uint16_t mid = (lo + hi) >> 1;
+    if (gUnicode[sorted[mid]] < unicode) lo = mid + 1;
+    else hi = mid;
+  }
+
+  if (lo < gFont.gCount && gUnicode[sorted[lo]] == unicode)
+  {
+    *index = sorted[lo];
+    return true;
   }
   return false;
 }
 
 
+/***************************************************************************************
+** Function name:           getKerning
+** Description:             Get the x adjustment for a pair of characters
+*************************************************************************************x*/
+int8_t TFT_eSPI::getKerning(uint16_t left, uint16_t right)
+{
+  if (gFont.kCount == 0) return 0;
+
+  uint32_t pair = (uint32_t)left << 16 | right;
+  uint16_t lo = 0;
+  uint16_t hi = gFont.kCount;
+
+  while (lo < hi)
+  {
+    uint16_t mid = (lo + hi) >> 1;
+    if (gKern[mid] < pair) lo = mid + 1;
+    else hi = mid;
+  }
+
+  if (lo < gFont.kCount && gKern[lo] == pair) return gKernAdj[lo];
+  return 0;
+}
+
+
 /***************************************************************************************
 ** Function name:           drawGlyph
 ** Description:             Write a character to the TFT cursor position
@@ -383,6 +757,8 @@ void TFT_eSPI::drawGlyph(uint16_t code)
   
   if (found)
   {
+    // Kern against the last glyph if the cursor has not been moved since
+    if (gFont.kCount && (cursor_x == kernX) && (cursor_y == kernY)) cursor_x += getKerning(kernCode, code);
 
     if (textwrapX && (cursor_x + gWidth[gNum] + gdX[gNum] > width()))
     {
@@ -393,23 +769,52 @@ void TFT_eSPI::drawGlyph(uint16_t code)
     if (cursor_x == 0) cursor_x -= gdX[gNum];
 
     uint8_t* pbuffer = nullptr;
+    const uint8_t* cbuffer = nullptr; // Whole glyph bitmap from the cache
     const uint8_t* gPtr = (const uint8_t*) gFont.gArray;
 
 #ifdef FONT_FS_AVAILABLE
-    if (fs_font)
+    if (fs_font || gFont.compact)
     {
-      fontFile.seek(gBitmap[gNum], fs::SeekSet); // This is taking >30ms for a significant position shift
-      pbuffer =  (uint8_t*)malloc(gWidth[gNum]);
+      cbuffer = getCachedGlyph(gNum); // Read before startWrite() so SD card reads do not need the SPI released
+      if (!cbuffer && !gFont.compact)
+      {
+        uint32_t size = gWidth[gNum] * gHeight[gNum];
+        fontFile.seek(gBitmap[gNum], fs::SeekSet); // This is taking >30ms for a significant position shift
+
+        // Read the whole bitmap in one file transaction if there is memory for it
+        pbuffer = (uint8_t*)malloc(size);
+        if (pbuffer && (fontFile.read(pbuffer, size) == size)) cbuffer = pbuffer;
+        else
+        {
+          if (pbuffer) free(pbuffer);
+          fontFile.seek(gBitmap[gNum], fs::SeekSet);
+          pbuffer =  (uint8_t*)malloc(gWidth[gNum]);
+        }
+      }
     }
 #endif
 
+    // Compact glyphs that are not cached are expanded into a temporary bitmap
+    if (gFont.compact && !cbuffer)
+    {
+      pbuffer = (uint8_t*)malloc(gWidth[gNum] * gHeight[gNum]);
+      if (pbuffer) decodeGlyph(gNum, pbuffer);
+      cbuffer = pbuffer;
+    }
+
     int16_t cy = cursor_y + gFont.maxAscent - gdY[gNum];
     int16_t cx = cursor_x + gdX[gNum];
 
     int16_t  xs = cx;
-    uint32_t dl = 0;
+    uint32_t np = 0;
     uint8_t pixel;
 
+    // Runs of non-zero alpha pixels are blended into a line buffer and sent with one
+    // window, zero alpha pixels are not drawn so the background shows through
+    uint16_t lineBuf[gWidth[gNum] ? gWidth[gNum] : 1];
+    bool swap = _swapBytes;
+    _swapBytes = true; // lineBuf holds native colour values
+
     startWrite(); // Avoid slow ESP32 transaction overhead for every pixel
 
     //if (fg!=bg) fillRect(cursor_x, cursor_y, gxAdvance[gNum], gFont.yAdvance, bg);
@@ -417,7 +822,7 @@ void TFT_eSPI::drawGlyph(uint16_t code)
     for (int y = 0; y < gHeight[gNum]; y++)
     {
 #ifdef FONT_FS_AVAILABLE
-      if (fs_font) {
+      if (pbuffer && !cbuffer) {
         if (spiffs)
         {
           fontFile.read(pbuffer, gWidth[gNum]);
@@ -434,40 +839,37 @@ void TFT_eSPI::drawGlyph(uint16_t code)
 #endif
       for (int x = 0; x < gWidth[gNum]; x++)
       {
+        if (cbuffer) pixel = cbuffer[x + gWidth[gNum] * y];
 #ifdef FONT_FS_AVAILABLE
-        if (fs_font) pixel = pbuffer[x];
-        else
+        else if (fs_font) pixel = pbuffer[x];
 #endif
-        pixel = pgm_read_byte(gPtr + gBitmap[gNum] + x + gWidth[gNum] * y);
+        else if (gFont.compact) pixel = 0; // No memory to expand the glyph
+        else pixel = pgm_read_byte(gPtr + gBitmap[gNum] + x + gWidth[gNum] * y);
 
         if (pixel)
         {
+          if (np == 0) xs = x + cx;
           if (pixel != 0xFF)
           {
-            if (dl) {
-              if (dl==1) drawPixel(xs, y + cy, fg);
-              else drawFastHLine( xs, y + cy, dl, fg);
-              dl = 0;
-            }
             if (getColor) bg = getColor(x + cx, y + cy);
-            drawPixel(x + cx, y + cy, alphaBlend(pixel, fg, bg));
-          }
-          else
-          {
-            if (dl==0) xs = x + cx;
-            dl++;
+            lineBuf[np++] = alphaBlend(pixel, fg, bg);
           }
+          else lineBuf[np++] = fg;
         }
         else
         {
-          if (dl) { drawFastHLine( xs, y + cy, dl, fg); dl = 0; }
+          if (np) { pushImage(xs, y + cy, np, 1, lineBuf); np = 0; }
         }
       }
-      if (dl) { drawFastHLine( xs, y + cy, dl, fg); dl = 0; }
+      if (np) { pushImage(xs, y + cy, np, 1, lineBuf); np = 0; }
     }
 
+    _swapBytes = swap; // Restore old value
     if (pbuffer) free(pbuffer);
     cursor_x += gxAdvance[gNum];
+    kernCode = code;
+    kernX = cursor_x;
+    kernY = cursor_y;
     endWrite();
   }
   else
@@ -478,6 +880,163 @@ void TFT_eSPI::drawGlyph(uint16_t code)
   }
 }
 
+/***************************************************************************************
+** Function name:           drawStringStrip
+** Description:             Draw a string with background as one strip, in bands of rows
+*************************************************************************************x*/
+// Gives the same result as filling the strip then calling drawGlyph for each character,
+// returns false (nothing drawn) for strings that would wrap or need the glyph fallback.
+// Glyphs from a font file are all read into the cache before the TFT is selected, so a
+// string is only drawn this way if all its glyphs fit in the cache together.
+bool TFT_eSPI::drawStringStrip(const char *string, int32_t poX, int32_t poY, int32_t cwidth, int32_t x0, int32_t x1)
+{
+  int32_t w = x1 - x0;
+  int32_t h = gFont.yAdvance;
+
+  if (getColor || (w < 1) || (h < 1)) return false;
+  if (textwrapY && ((poY + gFont.yAdvance) >= height())) return false;
+
+  int32_t rows = SMOOTH_STRIP_PIXELS / w;
+  if (rows < 1) return false;
+  if (rows > h) rows = h;
+
+  uint16_t len = strlen(string);
+  if (len > SMOOTH_STRIP_CHARS) return false;
+
+  uint16_t n = 0;
+  uint16_t gNum = 0;
+  int32_t  cx = poX;
+
+  // Glyph numbers, x positions and bitmaps from a single layout pass, used for every band
+  uint16_t glyphNum[SMOOTH_STRIP_CHARS];
+  int32_t  glyphX[SMOOTH_STRIP_CHARS];
+  const uint8_t* glyphPtr[SMOOTH_STRIP_CHARS];
+  uint16_t count = 0;
+  uint16_t last = 0;   // Previous glyph code for kerning, 0 after a space
+#ifdef FONT_FS_AVAILABLE
+  uint32_t cacheNeed = 0; // Cache bytes for the different glyphs in the string
+#endif
+
+  // Check each glyph falls inside the strip where drawGlyph would place it
+  while (n < len)
+  {
+    uint16_t code = decodeUTF8((uint8_t *) string, &n, len - n);
+    if (code == 0x20) { cx += gFont.spaceWidth; last = 0; continue; }
+    if (!getUnicodeIndex(code, &gNum)) return false; // Includes '\n'
+
+    if (last) cx += getKerning(last, code);
+    if (textwrapX && (cx + gWidth[gNum] + gdX[gNum] > width())) return false;
+    if (cx == 0) cx -= gdX[gNum];
+
+    int32_t gx = cx + gdX[gNum];
+    int32_t gy = poY + gFont.maxAscent - gdY[gNum];
+    if (gWidth[gNum] && gHeight[gNum])
+    {
+      if ((gx < x0) || (gx + gWidth[gNum] > x1)) return false;
+      if ((gy < poY) || (gy + gHeight[gNum] > poY + h)) return false;
+#ifdef FONT_FS_AVAILABLE
+      if (fs_font || gFont.compact)
+      {
+        uint16_t i = 0;
+        while ((i < count) && (glyphNum[i] != gNum)) i++;
+        if (i == count) cacheNeed += sizeof(glyphCacheEntry) + gWidth[gNum] * gHeight[gNum];
+        if (cacheNeed > glyphCacheSize) return false;
+      }
+#else
+      if (gFont.compact) return false;
+#endif
+    }
+    glyphNum[count] = gNum;
+    glyphX[count++] = gx - x0;
+    cx += gxAdvance[gNum];
+    last = code;
+  }
+
+  // Read any glyphs that are not cached now, the string fits so none are evicted here
+  for (uint16_t i = 0; i < count; i++)
+  {
+    gNum = glyphNum[i];
+    glyphPtr[i] = (const uint8_t*) gFont.gArray + gBitmap[gNum];
+#ifdef FONT_FS_AVAILABLE
+    if ((fs_font || gFont.compact) && gWidth[gNum] && gHeight[gNum])
+    {
+      glyphPtr[i] = getCachedGlyph(gNum);
+      if (glyphPtr[i] == nullptr) return false; // No memory or a read failed
+    }
+#endif
+  }
+
+  uint16_t* buffer = (uint16_t*)malloc(w * rows * 2);
+  if (buffer == nullptr) return false;
+
+  uint16_t fg = textcolor;
+  uint16_t bg = textbgcolor;
+
+  bool swap = _swapBytes;
+  _swapBytes = true; // buffer holds native colour values
+
+  startWrite();
+
+  for (int32_t by = 0; by < h; by += rows)
+  {
+    int32_t bh = (h - by < rows) ? h - by : rows;
+
+    for (int32_t i = 0; i < w * bh; i++) buffer[i] = bg;
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+      gNum = glyphNum[i];
+
+      uint8_t  gw = gWidth[gNum];
+      int32_t  gx = glyphX[i];
+      int32_t  gy = gFont.maxAscent - gdY[gNum] - by; // Glyph top row in this band
+      int32_t  ys = (gy < 0) ? -gy : 0;
+      int32_t  ye = (gy + gHeight[gNum] > bh) ? bh - gy : gHeight[gNum];
+
+      const uint8_t* gPtr = glyphPtr[i];
+
+      // The padding is filled after the text so clip glyphs to the text
+      int32_t xs = (gx < poX - x0) ? poX - x0 - gx : 0;
+      int32_t xe = (gx + gw > poX - x0 + cwidth) ? poX - x0 + cwidth - gx : gw;
+
+      for (int32_t y = ys; y < ye; y++)
+      {
+        uint16_t* dst = buffer + (gy + y) * w + gx;
+        for (int32_t x = xs; x < xe; x++)
+        {
+          uint8_t pixel;
+#ifdef FONT_FS_AVAILABLE
+          if (fs_font || gFont.compact) pixel = gPtr[x + gw * y];
+          else
+#endif
+          pixel = pgm_read_byte(gPtr + x + gw * y);
+
+          if (pixel == 0xFF) dst[x] = fg;
+          else if (pixel) dst[x] = alphaBlend(pixel, fg, bg);
+        }
+      }
+    }
+
+    pushImage(x0, poY + by, w, bh, buffer);
+  }
+
+  endWrite();
+
+  _swapBytes = swap; // Restore old value
+  free(buffer);
+
+  cursor_x = cx;
+  cursor_y = poY;
+
+  // Leave the kerning state as drawGlyph would
+  kernCode = last;
+  kernX = cx;
+  kernY = poY;
+
+  return true;
+}
+
+
 /***************************************************************************************
 ** Function name:           showFont
 ** Description:             Page through all characters in font, td ms between screens
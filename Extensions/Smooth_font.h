@@ -7,10 +7,21 @@
   void     loadFont(const uint8_t array[]);
 #ifdef FONT_FS_AVAILABLE
   void     loadFont(String fontName, fs::FS &ffs);
+
+  // Font file glyph bitmap cache, size in bytes (0 = disabled) and hit/miss counts
+  void     setGlyphCacheSize(uint32_t bytes);
+  void     getGlyphCacheStats(uint32_t *hits, uint32_t *misses, bool reset = false);
 #endif
   void     loadFont(String fontName, bool flash = true);
   void     unloadFont( void );
   bool     getUnicodeIndex(uint16_t unicode, uint16_t *index);
+  int8_t   getKerning(uint16_t left, uint16_t right); // Pair kerning x adjustment, 0 if none
+
+  // Several fonts can be resident, loadFont() and unloadFont() act on the selected
+  // handle (0 to SMOOTH_FONT_SLOTS-1), selecting a loaded handle does not reload it
+  void     selectFont(uint8_t handle);
+  uint8_t  getFontHandle(void);
+  void     unloadAllFonts(void); // Unload the font in every handle, the selected handle is kept
 
   virtual void drawGlyph(uint16_t code);
 
@@ -27,11 +38,15 @@
     int16_t  descent;                // Offset to bottom of 'p', other characters may have a larger descent
     uint16_t maxAscent;              // Maximum ascent found in font
     uint16_t maxDescent;             // Maximum descent found in font
+    bool     compact;                // 4 bit RLE bitmaps (Tools/Compress_Smooth_Font)
+    uint16_t kCount;                 // Number of kerning pairs (compact fonts only)
   } fontMetrics;
 
-fontMetrics gFont = { nullptr, 0, 0, 0, 0, 0, 0, 0 };
+fontMetrics gFont = { nullptr, 0, 0, 0, 0, 0, 0, 0, false, 0 };
 
   // These are for the metrics for each individual glyph (so we don't need to seek this in file and waste time)
+  // The arrays are all in one allocation (gArena), set up by mapMetrics()
+  uint8_t*  gArena = NULL;    //metrics arena
   uint16_t* gUnicode = NULL;  //UTF-16 code, the codes are searched so do not need to be sequential
   uint8_t*  gHeight = NULL;   //cheight
   uint8_t*  gWidth = NULL;    //cwidth
@@ -39,6 +54,13 @@ fontMetrics gFont = { nullptr, 0, 0, 0, 0, 0, 0, 0 };
   int16_t*  gdY = NULL;       //topExtent
   int8_t*   gdX = NULL;       //leftExtent
   uint32_t* gBitmap = NULL;   //file pointer to greyscale bitmap
+  uint16_t* gIndex = NULL;    //glyph numbers for codes 0-0x7F followed by all glyph numbers sorted by Unicode
+  uint32_t* gKern = NULL;     //kerning pairs, left code << 16 | right code, sorted
+  int8_t*   gKernAdj = NULL;  //kerning x adjustment for each pair
+
+  uint16_t kernCode = 0;      // Last glyph drawn and the cursor after it, for kerning the next glyph
+  int32_t  kernX = 0;
+  int32_t  kernY = 0;
 
   bool     fontLoaded = false; // Flags when a anti-aliased font is loaded
 
@@ -48,13 +70,63 @@ fontMetrics gFont = { nullptr, 0, 0, 0, 0, 0, 0, 0 };
   bool     spiffs   = true;
   bool     fs_font = false;    // For ESP32/8266 use smooth font file or FLASH (PROGMEM) array
 
-#else
+  uint8_t* fontBuf    = nullptr; // Read-ahead buffer used by readInt32 while a font file is loaded
+  uint16_t fontBufLen = 0;
+  uint16_t fontBufPos = 0;
+
+  // Glyph bitmaps read from the font file, most recently used first
+  typedef struct glyphCacheEntry
+  {
+    struct glyphCacheEntry* next;    // Next (less recently used) glyph
+    uint16_t gNum;                   // Glyph number, the alpha bitmap follows this header
+  } glyphCacheEntry;
+
+  glyphCacheEntry* glyphCache = nullptr;
+  uint32_t glyphCacheSize   = SMOOTH_GLYPH_CACHE; // Maximum bytes, including entry headers
+  uint32_t glyphCacheUsed   = 0;
+  uint32_t glyphCacheHits   = 0;
+  uint32_t glyphCacheMisses = 0;
+#endif
+
+  // Fonts that are loaded but not selected
+  typedef struct
+  {
+    fontMetrics gFont;
+    uint8_t*    gArena;
+    bool        fontLoaded;
+#ifdef FONT_FS_AVAILABLE
+    fs::File    fontFile;
+    bool        spiffs;
+    bool        fs_font;
+    glyphCacheEntry* glyphCache;
+    uint32_t    glyphCacheUsed;
+#endif
+  } fontSlot;
+
+  fontSlot fontSlots[SMOOTH_FONT_SLOTS] = {};
+  uint8_t  fontHandle = 0;     // Selected font slot
+
+#ifndef FONT_FS_AVAILABLE
   bool     fontFile = true;
 #endif
 
+  protected:
+
+  // Draw a string cwidth wide and its padding x0 to x1 as one strip with the background
+  // colour, returns false if the string must be drawn glyph by glyph
+  virtual bool drawStringStrip(const char *string, int32_t poX, int32_t poY, int32_t cwidth, int32_t x0, int32_t x1);
+
   private:
 
   void     loadMetrics(void);
+  void     mapMetrics(void);
+  void     decodeGlyph(uint16_t gNum, uint8_t* alpha);
+  void     buildIndex(void);
+#ifdef FONT_FS_AVAILABLE
+  const uint8_t* getCachedGlyph(uint16_t gNum);
+  void     evictGlyph(void);
+  void     flushGlyphCache(void);
+#endif
   uint32_t readInt32(void);
 
   uint8_t* fontPtr = nullptr;
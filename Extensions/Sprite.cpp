@@ -138,8 +138,10 @@ TFT_eSprite::~TFT_eSprite(void)
   deleteSprite();
 
 #ifdef SMOOTH_FONT
-  if(fontLoaded) unloadFont();
+  unloadAllFonts();
 #endif
+
+  setTextWidthCache(0);
 }
 
 
@@ -166,6 +168,14 @@ void* TFT_eSprite::callocSprite(int16_t w, int16_t h, uint8_t frames)
       //Serial.println("PSRAM");
     }
     else
+#endif
+#if defined (ESP32_DMA)
+    // Sprite is sent directly to the TFT by pushSpriteDMA() so it must be DMA capable
+    if (_tft->DMA_Enabled)
+    {
+      ptr8 = ( uint8_t*) heap_caps_calloc(frames * w * h + frames, sizeof(uint16_t), MALLOC_CAP_DMA);
+    }
+    else
 #endif
     {
       ptr8 = ( uint8_t*) calloc(frames * w * h + frames, sizeof(uint16_t));
@@ -705,6 +715,39 @@ void TFT_eSprite::pushSprite(int32_t x, int32_t y, uint16_t transp)
 }
 
 
+#if defined (ESP32_DMA)
+/***************************************************************************************
+** Function name:           pushSpriteDMA
+** Description:             Push a 16 bit sprite to the TFT at x, y using DMA
+***************************************************************************************/
+// 16 bit sprites hold pixels in the byte order sent to the TFT so DMA can read the sprite
+// memory directly, there is no copy or byte swap before the transfer is queued, even when
+// clipped. Sprites that are not 16 bit are pushed without DMA instead, as are all sprites
+// for 8 bit parallel displays because the I2S bus would need the sprite swapped in place.
+uint32_t TFT_eSprite::pushSpriteDMA(int32_t x, int32_t y, dmaDoneCallback done, void *arg)
+{
+  if (!_created) return _tft->dmaFence();
+
+#if defined (TFT_PARALLEL_8_BIT)
+  if (true)
+#else
+  if ( (_bpp != 16) || !_tft->DMA_Enabled )
+#endif
+  {
+    pushSprite(x, y);
+    return _tft->dmaFence();
+  }
+
+  bool oldSwapBytes = _tft->getSwapBytes();
+  _tft->setSwapBytes(false);
+  uint32_t fence = _tft->pushImageDMA(x, y, _dwidth, _dheight, _img, nullptr, done, arg);
+  _tft->setSwapBytes(oldSwapBytes);
+
+  return fence;
+}
+#endif
+
+
 /***************************************************************************************
 ** Function name:           pushToSprite
 ** Description:             Push the sprite to another sprite at x, y
@@ -2121,6 +2164,50 @@ void TFT_eSprite::drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uin
 }
 
 
+#ifdef LOAD_GLCD
+/***************************************************************************************
+** Function name:           drawStringGlcd
+** Description:             Not used for sprites, drawing in sprite memory is fast
+***************************************************************************************/
+bool TFT_eSprite::drawStringGlcd(const char *, int32_t, int32_t, int32_t, int32_t)
+{
+  return false;
+}
+#endif
+
+
+/***************************************************************************************
+** Function name:           pushAlphaRun
+** Description:             Write a run of blended pixels into the Sprite and empty it
+***************************************************************************************/
+void TFT_eSprite::pushAlphaRun(alphaRun &run, uint32_t fg, uint32_t bg)
+{
+  if (!run.n) return;
+
+  if (_bpp < 8)
+  {
+    // Palette and bitmap colours cannot be blended, pixels over half covered are drawn
+    for (uint16_t i = 0; i < run.n; i++)
+    {
+      if (run.alpha[i] & 0x80) drawPixel(run.x + (run.vertical ? 0 : i), run.y + (run.vertical ? i : 0), fg);
+    }
+  }
+  else
+  {
+    uint16_t buf[run.n];
+    blendAlphaRun(run, fg, bg, buf);
+
+    bool swap = _swapBytes;
+    _swapBytes = true; // buf holds native colour values
+    if (run.vertical) pushImage(run.x, run.y, 1, run.n, buf);
+    else pushImage(run.x, run.y, run.n, 1, buf);
+    _swapBytes = swap; // Restore old value
+  }
+
+  run.n = 0;
+}
+
+
 /***************************************************************************************
 ** Function name:           drawChar
 ** Description:             draw a unicode glyph onto the screen
@@ -2422,6 +2509,9 @@ void TFT_eSprite::drawGlyph(uint16_t code)
     }
     else
     {
+      // Kern against the last glyph if the cursor has not been moved since
+      if (gFont.kCount && (cursor_x == kernX) && (cursor_y == kernY)) cursor_x += getKerning(kernCode, code);
+
       if( textwrapX && ((cursor_x + gWidth[gNum] + gdX[gNum]) > width())) {
         cursor_y += gFont.yAdvance;
         cursor_x = 0;
@@ -2433,15 +2523,26 @@ void TFT_eSprite::drawGlyph(uint16_t code)
     }
 
     uint8_t* pbuffer = nullptr;
+    const uint8_t* cbuffer = nullptr; // Whole glyph bitmap from the cache
     const uint8_t* gPtr = (const uint8_t*) gFont.gArray;
 
 #ifdef FONT_FS_AVAILABLE
-    if (fs_font) {
-      fontFile.seek(gBitmap[gNum], fs::SeekSet); // This is slow for a significant position shift!
-      pbuffer =  (uint8_t*)malloc(gWidth[gNum]);
+    if (fs_font || gFont.compact) {
+      cbuffer = getCachedGlyph(gNum);
+      if (!cbuffer && !gFont.compact) {
+        fontFile.seek(gBitmap[gNum], fs::SeekSet); // This is slow for a significant position shift!
+        pbuffer =  (uint8_t*)malloc(gWidth[gNum]);
+      }
     }
 #endif
 
+    // Compact glyphs that are not cached are expanded into a temporary bitmap
+    if (gFont.compact && !cbuffer) {
+      pbuffer = (uint8_t*)malloc(gWidth[gNum] * gHeight[gNum]);
+      if (pbuffer) decodeGlyph(gNum, pbuffer);
+      cbuffer = pbuffer;
+    }
+
     int16_t  xs = 0;
     uint16_t dl = 0;
     uint8_t pixel = 0;
@@ -2451,18 +2552,24 @@ void TFT_eSprite::drawGlyph(uint16_t code)
     for (int32_t y = 0; y < gHeight[gNum]; y++)
     {
 #ifdef FONT_FS_AVAILABLE
-      if (fs_font) {
+      if (pbuffer && !cbuffer) {
         fontFile.read(pbuffer, gWidth[gNum]);
       }
 #endif
       for (int32_t x = 0; x < gWidth[gNum]; x++)
       {
+        if (cbuffer) {
+          pixel = cbuffer[x + gWidth[gNum] * y];
+        }
 #ifdef FONT_FS_AVAILABLE
-        if (fs_font) {
+        else if (fs_font) {
           pixel = pbuffer[x];
         }
-        else
 #endif
+        else if (gFont.compact) {
+          pixel = 0; // No memory to expand the glyph
+        }
+        else
         pixel = pgm_read_byte(gPtr + gBitmap[gNum] + x + gWidth[gNum] * y);
 
         if (pixel)
@@ -2498,6 +2605,9 @@ void TFT_eSprite::drawGlyph(uint16_t code)
       deleteSprite();
     }
     cursor_x += gxAdvance[gNum];
+    kernCode = code;
+    kernX = cursor_x;
+    kernY = cursor_y;
   }
   else
   {
@@ -2508,6 +2618,16 @@ void TFT_eSprite::drawGlyph(uint16_t code)
 }
 
 
+/***************************************************************************************
+** Function name:           drawStringStrip
+** Description:             Not used for sprites, drawing in sprite memory is fast
+***************************************************************************************/
+bool TFT_eSprite::drawStringStrip(const char *, int32_t, int32_t, int32_t, int32_t, int32_t)
+{
+  return false;
+}
+
+
 /***************************************************************************************
 ** Function name:           printToSprite
 ** Description:             Write a string to the sprite cursor position
@@ -2530,21 +2650,26 @@ void TFT_eSprite::printToSprite(char *cbuffer, uint16_t len) //String string)
   uint16_t n = 0;
   bool newSprite = !_created;
 
+  kernCode = 0;
+
   if (newSprite)
   {
     int16_t sWidth = 1;
     uint16_t index = 0;
+    uint16_t last = 0;
 
     while (n < len)
     {
       uint16_t unicode = decodeUTF8((uint8_t*)cbuffer, &n, len - n);
       if (getUnicodeIndex(unicode, &index))
       {
+        if (last) sWidth += getKerning(last, unicode);
+        last = unicode;
         if (n == 0) sWidth -= gdX[index];
         if (n == len-1) sWidth += ( gWidth[index] + gdX[index]);
         else sWidth += gxAdvance[index];
       }
-      else sWidth += gFont.spaceWidth + 1;
+      else { sWidth += gFont.spaceWidth + 1; last = 0; }
     }
 
     createSprite(sWidth, gFont.yAdvance);
@@ -53,6 +53,8 @@ class TFT_eSprite : public TFT_eSPI {
   void     setBitmapColor(uint16_t fg, uint16_t bg);
 
   void     drawPixel(int32_t x, int32_t y, uint32_t color);
+           // Keep the alpha blended drawPixel() of the TFT_eSPI class visible
+  using    TFT_eSPI::drawPixel;
 
   void     drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32_t bg, uint8_t font),
 
@@ -124,6 +126,11 @@ class TFT_eSprite : public TFT_eSPI {
            // Push a windowed area of the sprite to the TFT at tx, ty
   bool     pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int32_t sw, int32_t sh);
 
+           // Push a 16 bit sprite to the TFT by DMA straight from sprite memory (no copy or byte swap),
+           // returns the DMA fence. Do not draw in the sprite until the fence is done, or create the
+           // sprite with 2 frames and use frameBuffer() to draw in one frame while the other is sent.
+  uint32_t pushSpriteDMA(int32_t x, int32_t y, dmaDoneCallback done = nullptr, void *arg = nullptr);
+
            // Push the sprite to another sprite at x,y. This fn calls pushImage() in the destination sprite (dspr) class.
            // >>>>>>  Using a transparent color is not supported at the moment  <<<<<<
   bool     pushToSprite(TFT_eSprite *dspr, int32_t x, int32_t y);
@@ -142,6 +149,19 @@ class TFT_eSprite : public TFT_eSPI {
   void     printToSprite(char *cbuffer, uint16_t len);
   int16_t  printToSprite(int16_t x, int16_t y, uint16_t index);
 
+ protected:
+
+#ifdef SMOOTH_FONT
+           // Sprites draw smooth font strings glyph by glyph
+  bool     drawStringStrip(const char *string, int32_t poX, int32_t poY, int32_t cwidth, int32_t x0, int32_t x1);
+#endif
+#ifdef LOAD_GLCD
+           // Sprites draw GLCD font strings character by character
+  bool     drawStringGlcd(const char *string, int32_t poX, int32_t poY, int32_t x0, int32_t x1);
+#endif
+           // Anti-aliased pixel runs are written to the Sprite buffer
+  void     pushAlphaRun(alphaRun &run, uint32_t fg, uint32_t bg);
+
  private:
 
   TFT_eSPI *_tft;
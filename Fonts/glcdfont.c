@@ -5,7 +5,12 @@
 
 // Standard ASCII 5x7 font
 
+// constexpr in C++ so the row ordered copy in glcdfont_rows.h is made at compile time
+#ifdef __cplusplus
+static constexpr unsigned char font[] PROGMEM = {
+#else
 static const unsigned char font[] PROGMEM = {
+#endif
 	0x00, 0x00, 0x00, 0x00, 0x00,
 	0x3E, 0x5B, 0x4F, 0x5B, 0x3E,
 	0x3E, 0x6B, 0x4F, 0x6B, 0x3E,
@@ -0,0 +1,45 @@
+// Row ordered copy of the GLCD font in glcdfont.c, made by the compiler
+
+// glcdfont.c stores each 5x7 character as 5 column bytes (bit 0 = top row). Text is
+// sent to the display a row at a time, so this table holds 8 row bytes per character
+// with column 0 in bit 7 down to column 4 in bit 3. The table is built at compile time
+// from the font array, so edits to glcdfont.c are picked up automatically.
+
+#ifndef GLCDFONT_ROWS_H
+#define GLCDFONT_ROWS_H
+
+#define GLCD_CHARS (sizeof(font) / 5) // Number of characters in the font
+
+// Row byte i of the table, character i / 8, row i % 8
+constexpr uint8_t glcdRow(uint32_t i) {
+  return ((font[(i >> 3) * 5 + 0] >> (i & 7)) & 1) << 7 |
+         ((font[(i >> 3) * 5 + 1] >> (i & 7)) & 1) << 6 |
+         ((font[(i >> 3) * 5 + 2] >> (i & 7)) & 1) << 5 |
+         ((font[(i >> 3) * 5 + 3] >> (i & 7)) & 1) << 4 |
+         ((font[(i >> 3) * 5 + 4] >> (i & 7)) & 1) << 3;
+}
+
+// C++11 compatible index list 0 to N-1, built by halving to keep the template depth low
+template<uint32_t... I> struct glcdIndex {};
+
+template<typename A, typename B> struct glcdJoin;
+template<uint32_t... A, uint32_t... B> struct glcdJoin<glcdIndex<A...>, glcdIndex<B...>> {
+  typedef glcdIndex<A..., (sizeof...(A) + B)...> type;
+};
+
+template<uint32_t N> struct glcdCount {
+  typedef typename glcdJoin<typename glcdCount<N / 2>::type, typename glcdCount<N - N / 2>::type>::type type;
+};
+template<> struct glcdCount<0> { typedef glcdIndex<> type; };
+template<> struct glcdCount<1> { typedef glcdIndex<0> type; };
+
+template<typename T> struct glcdRowTable;
+template<uint32_t... I> struct glcdRowTable<glcdIndex<I...>> {
+  static const uint8_t rows[sizeof...(I)];
+};
+template<uint32_t... I> const uint8_t glcdRowTable<glcdIndex<I...>>::rows[sizeof...(I)] PROGMEM = { glcdRow(I)... };
+
+// 8 row bytes per character, glcdRowData::rows[c * 8 + row]
+typedef glcdRowTable<glcdCount<GLCD_CHARS * 8>::type> glcdRowData;
+
+#endif // GLCDFONT_ROWS_H
@@ -16,7 +16,7 @@
   #endif
 #endif
 
-#ifdef ESP32_DMA
+#if defined (ESP32_DMA) && !defined (TFT_PARALLEL_8_BIT)
   // DMA SPA handle
   spi_device_handle_t dmaHAL;
   #ifdef USE_HSPI_PORT
@@ -24,6 +24,37 @@
   #else
     spi_host_device_t spi_host = VSPI_HOST;
   #endif
+
+  // Ring of DMA transaction descriptors, the SPI driver completes them in queue order
+  // so the oldest queued slot is always the next one to be returned as finished
+  spi_transaction_t dmaTrans[DMA_QUEUE_SIZE];
+  uint8_t dmaHead = 0; // Index of the oldest transaction still queued
+
+  dmaDoneCallback dmaDoneCb[DMA_QUEUE_SIZE];  // Optional completion callback for each slot
+  void* dmaDoneArg[DMA_QUEUE_SIZE];           // and the sketch parameter passed to it
+
+  // Pre-filled colour buffer for DMA block fills, queued repeatedly to cover long runs
+  uint16_t* dmaFillBuf = nullptr;
+  uint16_t  dmaFillColor = 0; // Buffer colour, already byte swapped for the SPI bus
+
+  #if defined (SPI_18BIT_DRIVER)
+    // Bounce buffers for 16 to 18 bit colour expansion, and the fence of the last transfer from each
+    uint8_t*  dmaBounce[2] = { nullptr, nullptr };
+    uint32_t  dmaBounceFence[2] = { 0, 0 };
+    uint8_t   dmaBounceNext = 0;
+  #endif
+#elif defined (ESP32_DMA) // 8 bit parallel uses the I2S peripheral in LCD mode
+  // Linked list of descriptors covering one transfer, each can point at up to 4092 bytes
+  lldesc_t* dmaDesc = nullptr;
+  dmaDoneCallback dmaDoneCb = nullptr; // Optional completion callback for the transfer
+  void* dmaDoneArg = nullptr;          // and the sketch parameter passed to it
+#endif
+
+#ifdef ESP32_DMA
+  // Fences count transfers, each queued transfer takes the next fence value and completions
+  // are counted as they end, so a fence is done when the completion count reaches it
+  uint32_t dmaFenceQueued = 0;
+  volatile uint32_t dmaFenceComplete = 0;
 #endif
 
 #if !defined (TFT_PARALLEL_8_BIT)
@@ -241,6 +272,11 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
 //*
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
 
+  // Long runs are handed to the DMA engine so the CPU is free while the fill is sent
+  if (DMA_Enabled && (len >= DMA_FILL_MIN)) { pushBlockDMA(color, len); return; }
+
+  DMA_BUSY_CHECK; // SPI registers must not be written while a DMA transfer is in progress
+
   volatile uint32_t* spi_w = _spi_w;
   uint32_t color32 = (color<<8 | color >>8)<<16 | (color<<8 | color >>8);  
   uint32_t i = 0;
@@ -342,7 +378,7 @@ void TFT_eSPI::pushSwapBytePixels(const void* data_in, uint32_t len){
   {
     while (READ_PERI_REG(SPI_CMD_REG(SPI_PORT))&SPI_USR);
     WRITE_PERI_REG(SPI_MOSI_DLEN_REG(SPI_PORT), (len << 4) - 1);
-    for (uint32_t i=0; i <= (len<<1); i+=4) {
+    for (uint32_t i=0; i < (len<<1); i+=4) {
       WRITE_PERI_REG(SPI_W0_REG(SPI_PORT)+i, DAT8TO32(data)); data+=4;
     }
     SET_PERI_REG_MASK(SPI_CMD_REG(SPI_PORT), SPI_USR);
@@ -395,7 +431,7 @@ void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
   {
     while (READ_PERI_REG(SPI_CMD_REG(SPI_PORT))&SPI_USR);
     WRITE_PERI_REG(SPI_MOSI_DLEN_REG(SPI_PORT), (len << 4) - 1);
-    for (uint32_t i=0; i <= (len<<1); i+=4) WRITE_PERI_REG((SPI_W0_REG(SPI_PORT) + i), *data++);
+    for (uint32_t i=0; i < (len<<1); i+=4) WRITE_PERI_REG((SPI_W0_REG(SPI_PORT) + i), *data++);
     SET_PERI_REG_MASK(SPI_CMD_REG(SPI_PORT), SPI_USR);
   }
   while (READ_PERI_REG(SPI_CMD_REG(SPI_PORT))&SPI_USR);
@@ -411,6 +447,11 @@ void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 {
+  // Long runs are handed to the DMA engine so the CPU is free while the fill is sent
+  if (DMA_Enabled && (len >= DMA_FILL_MIN)) { pushBlockDMA(color, len); return; }
+
+  DMA_BUSY_CHECK; // SPI registers must not be written while a DMA transfer is in progress
+
   // Split out the colours
   uint32_t r = (color & 0xF800)>>8;
   uint32_t g = (color & 0x07E0)<<5;
@@ -562,12 +603,12 @@ bool TFT_eSPI::dmaBusy(void)
   if (!DMA_Enabled || !spiBusyCheck) return false;
 
   spi_transaction_t *rtrans;
-  esp_err_t ret;
-  uint8_t checks = spiBusyCheck;
-  for (int i = 0; i < checks; ++i)
+
+  // Retire every slot that has completed, stop at the first one still in progress
+  while (spiBusyCheck)
   {
-    ret = spi_device_get_trans_result(dmaHAL, &rtrans, 0);
-    if (ret == ESP_OK) spiBusyCheck--;
+    if (spi_device_get_trans_result(dmaHAL, &rtrans, 0) != ESP_OK) break;
+    dmaRetire(rtrans);
   }
 
   //Serial.print("spiBusyCheck=");Serial.println(spiBusyCheck);
@@ -583,14 +624,157 @@ bool TFT_eSPI::dmaBusy(void)
 void TFT_eSPI::dmaWait(void)
 {
   if (!DMA_Enabled || !spiBusyCheck) return;
+  dmaWaitQueue(0);
+}
+
+
+/***************************************************************************************
+** Function name:           dmaWaitFence
+** Description:             Wait until the transaction with this fence has completed (blocking!)
+***************************************************************************************/
+void TFT_eSPI::dmaWaitFence(uint32_t fence)
+{
+  if (!DMA_Enabled) return;
+
   spi_transaction_t *rtrans;
   esp_err_t ret;
-  for (int i = 0; i < spiBusyCheck; ++i)
+  while (spiBusyCheck && !dmaFenceDone(fence))
   {
     ret = spi_device_get_trans_result(dmaHAL, &rtrans, portMAX_DELAY);
     assert(ret == ESP_OK);
+    dmaRetire(rtrans);
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           dmaWaitQueue
+** Description:             Wait until no more than "depth" transactions are queued
+***************************************************************************************/
+void TFT_eSPI::dmaWaitQueue(uint8_t depth)
+{
+  spi_transaction_t *rtrans;
+  esp_err_t ret;
+  while (spiBusyCheck > depth)
+  {
+    ret = spi_device_get_trans_result(dmaHAL, &rtrans, portMAX_DELAY);
+    assert(ret == ESP_OK);
+    dmaRetire(rtrans);
   }
-  spiBusyCheck = 0;
+}
+
+
+/***************************************************************************************
+** Function name:           dmaRetire
+** Description:             Release the oldest queued slot after its transfer completed
+***************************************************************************************/
+void TFT_eSPI::dmaRetire(spi_transaction_t *rtrans)
+{
+  // Results are returned in queue order so this must be the oldest slot
+  assert(rtrans == &dmaTrans[dmaHead]);
+  (void)rtrans;
+
+  if (++dmaHead >= DMA_QUEUE_SIZE) dmaHead = 0;
+  spiBusyCheck--;
+}
+
+
+/***************************************************************************************
+** Function name:           dmaSlot
+** Description:             Get a free transaction slot, waits if all slots are queued
+***************************************************************************************/
+spi_transaction_t* TFT_eSPI::dmaSlot(void)
+{
+  // If the ring is full then wait for the oldest transfer to finish and recycle it
+  dmaWaitQueue(DMA_QUEUE_SIZE - 1);
+
+  uint32_t slot = dmaHead + spiBusyCheck;
+  if (slot >= DMA_QUEUE_SIZE) slot -= DMA_QUEUE_SIZE;
+
+  spi_transaction_t *trans = &dmaTrans[slot];
+  memset(trans, 0, sizeof(spi_transaction_t));
+
+  return trans;
+}
+
+
+/***************************************************************************************
+** Function name:           dmaQueue
+** Description:             Queue a transaction slot obtained from dmaSlot(), returns its fence
+***************************************************************************************/
+uint32_t TFT_eSPI::dmaQueue(spi_transaction_t *trans, dmaDoneCallback done, void *arg)
+{
+  uint32_t slot = trans - dmaTrans;
+  dmaDoneCb[slot]  = done;
+  dmaDoneArg[slot] = arg;
+
+  esp_err_t ret = spi_device_queue_trans(dmaHAL, trans, portMAX_DELAY);
+  assert(ret == ESP_OK);
+  (void)ret;
+
+  spiBusyCheck++;
+  return ++dmaFenceQueued;
+}
+
+
+/***************************************************************************************
+** Function name:           dmaBytes
+** Description:             Queue a command or up to 4 data bytes held in the transaction
+***************************************************************************************/
+// The bytes are sent from the most significant end of "data", dc_callback sets the DC line
+void TFT_eSPI::dmaBytes(bool dc, uint32_t data, uint8_t len)
+{
+  spi_transaction_t *trans = dmaSlot();
+
+  trans->user = (void *)dc;   // DC level: false = command, true = data
+  trans->length = len * 8;    //Data length, in bits
+  trans->flags = SPI_TRANS_USE_TXDATA;
+  trans->tx_data[0] = data >> 24;
+  trans->tx_data[1] = data >> 16;
+  trans->tx_data[2] = data >> 8;
+  trans->tx_data[3] = data;
+
+  dmaQueue(trans);
+}
+
+
+/***************************************************************************************
+** Function name:           setAddrWindowDMA
+** Description:             Queue the window commands so pixels can follow by DMA
+***************************************************************************************/
+// Same as setAddrWindow() but does not wait for earlier DMA transfers to complete
+void TFT_eSPI::setAddrWindowDMA(int32_t x0, int32_t y0, int32_t w, int32_t h)
+{
+  if (!DMA_Enabled) { setAddrWindow(x0, y0, w, h); return; }
+
+  int32_t x1 = x0 + w - 1;
+  int32_t y1 = y0 + h - 1;
+
+#ifdef CGRAM_OFFSET
+  x0 += colstart;
+  x1 += colstart;
+  y0 += rowstart;
+  y1 += rowstart;
+#endif
+
+  // Commands are sent in queue order so the window cache is valid for queued commands too
+  if ((addr_col != x0) || (win_xe != x1)) {
+    dmaBytes(false, TFT_CASET << 24, 1);
+    dmaBytes(true,  (uint32_t)x0 << 16 | (uint16_t)x1, 4);
+    addr_col = x0;
+    win_xe = x1;
+  }
+  else winBytesSaved += 5;
+
+  if ((addr_row != y0) || (win_ye != y1)) {
+    dmaBytes(false, TFT_PASET << 24, 1);
+    dmaBytes(true,  (uint32_t)y0 << 16 | (uint16_t)y1, 4);
+    addr_row = y0;
+    win_ye = y1;
+  }
+  else winBytesSaved += 5;
+
+  dmaBytes(false, TFT_RAMWR << 24, 1);
 }
 
 
@@ -599,30 +783,26 @@ void TFT_eSPI::dmaWait(void)
 ** Description:             Push pixels to TFT (len must be less than 32767)
 ***************************************************************************************/
 // This will byte swap the original image if setSwapBytes(true) was called by sketch.
-void TFT_eSPI::pushPixelsDMA(uint16_t* image, uint32_t len)
+uint32_t TFT_eSPI::pushPixelsDMA(uint16_t* image, uint32_t len, dmaDoneCallback done, void *arg)
 {
-  if ((len == 0) || (!DMA_Enabled)) return;
-
-  dmaWait();
+  if ((len == 0) || (!DMA_Enabled)) return dmaFenceQueued;
 
+#if defined (SPI_18BIT_DRIVER)
+  return dmaExpand666(image, len, done, arg);
+#else
   if(_swapBytes) {
     for (uint32_t i = 0; i < len; i++) (image[i] = image[i] << 8 | image[i] >> 8);
   }
 
-  esp_err_t ret;
-  static spi_transaction_t trans;
-
-  memset(&trans, 0, sizeof(spi_transaction_t));
+  spi_transaction_t *trans = dmaSlot(); // Only waits if all queue slots are in use
 
-  trans.user = (void *)1;
-  trans.tx_buffer = image;  //finally send the line data
-  trans.length = len * 16;        //Data length, in bits
-  trans.flags = 0;                //SPI_TRANS_USE_TXDATA flag
+  trans->user = (void *)1;
+  trans->tx_buffer = image;  //finally send the line data
+  trans->length = len * 16;        //Data length, in bits
+  trans->flags = 0;                //SPI_TRANS_USE_TXDATA flag
 
-  ret = spi_device_queue_trans(dmaHAL, &trans, portMAX_DELAY);
-  assert(ret == ESP_OK);
-
-  spiBusyCheck++;
+  return dmaQueue(trans, done, arg);
+#endif
 }
 
 
@@ -631,9 +811,10 @@ void TFT_eSPI::pushPixelsDMA(uint16_t* image, uint32_t len)
 ** Description:             Push image to a window (w*h must be less than 65536)
 ***************************************************************************************/
 // This will clip and also swap bytes if setSwapBytes(true) was called by sketch
-void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* image, uint16_t* buffer)
+uint32_t TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* image, uint16_t* buffer,
+                                dmaDoneCallback done, void *arg)
 {
-  if ((x >= _vpW) || (y >= _vpH) || (!DMA_Enabled)) return;
+  if ((x >= _vpW) || (y >= _vpH) || (!DMA_Enabled)) return dmaFenceQueued;
 
   int32_t dx = 0;
   int32_t dy = 0;
@@ -646,13 +827,34 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
   if ((x + dw) > _vpW ) dw = _vpW - x;
   if ((y + dh) > _vpH ) dh = _vpH - y;
 
-  if (dw < 1 || dh < 1) return;
+  if (dw < 1 || dh < 1) return dmaFenceQueued;
+
+  // A clipped image that needs no byte swap is sent straight from the source with one
+  // transfer per row, or a single transfer if only the top and/or bottom is clipped
+  bool direct = (buffer == nullptr) && !_swapBytes && ((dw != w) || (dh != h));
+#if defined (SPI_18BIT_DRIVER)
+  direct = true; // 18 bit colours are always expanded from the source, it is not changed
+#endif
+
+  if (direct) {
+    setAddrWindowDMA(x, y, dw, dh);
+
+    uint16_t* row = image + dx + w * dy;
+    if (dw == w) return pushPixelsDMA(row, dw * dh, done, arg);
+
+    while (--dh) {
+      pushPixelsDMA(row, dw);
+      row += w;
+    }
+    return pushPixelsDMA(row, dw, done, arg);
+  }
 
   uint32_t len = dw*dh;
 
   if (buffer == nullptr) {
     buffer = image;
-    dmaWait();
+    // The image is changed in place when swapped, so it must not still be queued
+    if (_swapBytes) dmaWait();
   }
 
   // If image is clipped, copy pixels into a contiguous block
@@ -681,24 +883,109 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
     }
   }
 
-  if (spiBusyCheck) dmaWait(); // In case we did not wait earlier
+  setAddrWindowDMA(x, y, dw, dh); // Window commands are queued ahead of the image
 
-  setAddrWindow(x, y, dw, dh);
+  spi_transaction_t *trans = dmaSlot();
 
-  esp_err_t ret;
-  static spi_transaction_t trans;
+  trans->user = (void *)1;
+  trans->tx_buffer = buffer;  //finally send the line data
+  trans->length = len * 16;   //Data length, in bits
+  trans->flags = 0;           //SPI_TRANS_USE_TXDATA flag
 
-  memset(&trans, 0, sizeof(spi_transaction_t));
+  return dmaQueue(trans, done, arg);
+}
 
-  trans.user = (void *)1;
-  trans.tx_buffer = buffer;  //finally send the line data
-  trans.length = len * 16;   //Data length, in bits
-  trans.flags = 0;           //SPI_TRANS_USE_TXDATA flag
+#if defined (SPI_18BIT_DRIVER)
+/***************************************************************************************
+** Function name:           dmaExpand666
+** Description:             Queue 16 bit pixels for an 18 bit display via bounce buffers
+***************************************************************************************/
+// Pixels are converted to 3 byte colours in one bounce buffer while the other is sent, so
+// the image is never changed and can be re-used as soon as this function returns
+uint32_t TFT_eSPI::dmaExpand666(const uint16_t* image, uint32_t len, dmaDoneCallback done, void *arg)
+{
+  uint32_t fence = dmaFenceQueued;
 
-  ret = spi_device_queue_trans(dmaHAL, &trans, portMAX_DELAY);
-  assert(ret == ESP_OK);
+  while (len)
+  {
+    uint32_t n = (len > DMA_BOUNCE_PIXELS) ? DMA_BOUNCE_PIXELS : len;
+    len -= n;
+
+    // Wait for the previous transfer from this buffer, the other may still be in progress
+    uint8_t b = dmaBounceNext;
+    dmaBounceNext ^= 1;
+    dmaWaitFence(dmaBounceFence[b]);
+
+    uint8_t* p = dmaBounce[b];
+    for (uint32_t i = 0; i < n; i++) {
+      uint16_t color = image[i];
+      if (!_swapBytes) color = color << 8 | color >> 8;
+      *p++ = (color & 0xF800)>>8;
+      *p++ = (color & 0x07E0)>>3;
+      *p++ = (color & 0x001F)<<3;
+    }
+    image += n;
 
-  spiBusyCheck++;
+    spi_transaction_t *trans = dmaSlot(); // Only waits if all queue slots are in use
+
+    trans->user = (void *)1;
+    trans->tx_buffer = dmaBounce[b];
+    trans->length = n * 24;   //Data length, in bits
+    trans->flags = 0;
+
+    // Only the last transfer calls the sketch back
+    fence = dmaQueue(trans, len ? nullptr : done, arg);
+    dmaBounceFence[b] = fence;
+  }
+
+  return fence;
+}
+#endif
+
+/***************************************************************************************
+** Function name:           pushBlockDMA
+** Description:             Queue DMA transfers to write a block of pixels of the same colour
+***************************************************************************************/
+// Called by pushBlock() for long runs. The same pre-filled buffer is queued as many times
+// as needed, this returns as soon as the last transfer is queued and the transfers are
+// retired by the next dmaWait(), e.g. in endWrite() or before the next CPU bus write.
+void TFT_eSPI::pushBlockDMA(uint16_t color, uint32_t len)
+{
+#if !defined (SPI_18BIT_DRIVER)
+  color = (color << 8) | (color >> 8); // Buffer holds pixels in SPI byte order
+#endif
+
+  // Queued transfers may still be reading the buffer so wait before changing the colour
+  if (color != dmaFillColor)
+  {
+    dmaWait();
+  #if defined (SPI_18BIT_DRIVER)
+    uint8_t* p = (uint8_t*)dmaFillBuf;
+    for (uint32_t i = 0; i < DMA_FILL_BUFFER; i++) {
+      *p++ = (color & 0xF800)>>8;
+      *p++ = (color & 0x07E0)>>3;
+      *p++ = (color & 0x001F)<<3;
+    }
+  #else
+    for (uint32_t i = 0; i < DMA_FILL_BUFFER; i++) dmaFillBuf[i] = color;
+  #endif
+    dmaFillColor = color;
+  }
+
+  while (len)
+  {
+    uint32_t n = (len > DMA_FILL_BUFFER) ? DMA_FILL_BUFFER : len;
+
+    spi_transaction_t *trans = dmaSlot(); // Only waits if all queue slots are in use
+
+    trans->user = (void *)1;
+    trans->tx_buffer = dmaFillBuf;
+    trans->length = n * DMA_PIXEL_BYTES * 8; //Data length, in bits
+    trans->flags = 0;
+
+    dmaQueue(trans);
+    len -= n;
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -718,6 +1005,19 @@ void IRAM_ATTR dc_callback(spi_transaction_t *spi_tx)
   else {DC_C;}
 }
 
+/***************************************************************************************
+** Function name:           dma_end_callback
+** Description:             Counts completed transactions and calls any sketch callback
+***************************************************************************************/
+// Called by the SPI driver in the interrupt context when a queued transaction ends
+void IRAM_ATTR dma_end_callback(spi_transaction_t *spi_tx)
+{
+  uint32_t slot = spi_tx - dmaTrans;
+  uint32_t fence = dmaFenceComplete + 1;
+  dmaFenceComplete = fence;
+  if (dmaDoneCb[slot]) dmaDoneCb[slot](fence, dmaDoneArg[slot]);
+}
+
 /***************************************************************************************
 ** Function name:           initDMA
 ** Description:             Initialise the DMA engine - returns true if init OK
@@ -753,17 +1053,44 @@ bool TFT_eSPI::initDMA(bool ctrl_cs)
     .input_delay_ns = 0,
     .spics_io_num = pin,
     .flags = SPI_DEVICE_NO_DUMMY, //0,
-    .queue_size = 1,
-    .pre_cb = 0, //dc_callback, //Callback to handle D/C line
-    .post_cb = 0
+    .queue_size = DMA_QUEUE_SIZE,
+    .pre_cb = dc_callback, //Callback to handle D/C line
+    .post_cb = dma_end_callback // Count completed transactions for fences
   };
   ret = spi_bus_initialize(spi_host, &buscfg, 1);
   ESP_ERROR_CHECK(ret);
   ret = spi_bus_add_device(spi_host, &devcfg, &dmaHAL);
   ESP_ERROR_CHECK(ret);
 
+  // The block fill buffer must be in DMA capable (internal) RAM
+  dmaFillBuf = (uint16_t*)heap_caps_calloc(DMA_FILL_BUFFER, DMA_PIXEL_BYTES, MALLOC_CAP_DMA);
+#if defined (SPI_18BIT_DRIVER)
+  dmaBounce[0] = (uint8_t*)heap_caps_malloc(DMA_BOUNCE_PIXELS * 3, MALLOC_CAP_DMA);
+  dmaBounce[1] = (uint8_t*)heap_caps_malloc(DMA_BOUNCE_PIXELS * 3, MALLOC_CAP_DMA);
+  if (dmaBounce[0] == nullptr || dmaBounce[1] == nullptr)
+  {
+    heap_caps_free(dmaBounce[0]);
+    heap_caps_free(dmaBounce[1]);
+    dmaBounce[0] = dmaBounce[1] = nullptr;
+    heap_caps_free(dmaFillBuf);
+    dmaFillBuf = nullptr;
+  }
+#endif
+  if (dmaFillBuf == nullptr)
+  {
+    spi_bus_remove_device(dmaHAL);
+    spi_bus_free(spi_host);
+    return false;
+  }
+  dmaFillColor = 0; // Buffer is cleared to black
+
   DMA_Enabled = true;
   spiBusyCheck = 0;
+  dmaHead = 0;
+  dmaFenceComplete = dmaFenceQueued; // Nothing is in flight so all fences are complete
+#if defined (SPI_18BIT_DRIVER)
+  dmaBounceFence[0] = dmaBounceFence[1] = dmaFenceQueued;
+#endif
   return true;
 }
 
@@ -774,11 +1101,439 @@ bool TFT_eSPI::initDMA(bool ctrl_cs)
 void TFT_eSPI::deInitDMA(void)
 {
   if (!DMA_Enabled) return;
+  dmaWait(); // Queued descriptors must not be released while in use
   spi_bus_remove_device(dmaHAL);
   spi_bus_free(spi_host);
+  heap_caps_free(dmaFillBuf);
+  dmaFillBuf = nullptr;
+#if defined (SPI_18BIT_DRIVER)
+  heap_caps_free(dmaBounce[0]);
+  heap_caps_free(dmaBounce[1]);
+  dmaBounce[0] = dmaBounce[1] = nullptr;
+#endif
+  DMA_Enabled = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+#elif defined (ESP32_DMA) //       I2S DMA FUNCTIONS FOR 8 BIT PARALLEL
+////////////////////////////////////////////////////////////////////////////////////////
+
+// The I2S peripheral in LCD mode clocks bytes onto the data bus with WS as the WR strobe.
+// In 8 bit mode each pair of bytes in memory is sent in reverse order, so native (little
+// endian) 16 bit colours reach the TFT most significant byte first without a byte swap.
+// The data and WR pins are only routed to the I2S peripheral while a transfer is running.
+
+/***************************************************************************************
+** Function name:           dmaBusy
+** Description:             Check if DMA is busy
+***************************************************************************************/
+bool TFT_eSPI::dmaBusy(void)
+{
+  if (!DMA_Enabled || !spiBusyCheck) return false;
+
+  // Busy until the last descriptor has been read and the FIFO is empty
+  if (!I2S0.int_raw.out_total_eof || !I2S0.state.tx_idle) return true;
+
+  dmaRetire();
+  return false;
+}
+
+
+/***************************************************************************************
+** Function name:           dmaWait
+** Description:             Wait until DMA is over (blocking!)
+***************************************************************************************/
+void TFT_eSPI::dmaWait(void)
+{
+  while (dmaBusy());
+}
+
+
+/***************************************************************************************
+** Function name:           dmaWaitQueue
+** Description:             Wait until no more than "depth" transfers are in progress
+***************************************************************************************/
+void TFT_eSPI::dmaWaitQueue(uint8_t depth)
+{
+  if (spiBusyCheck > depth) dmaWait();
+}
+
+
+/***************************************************************************************
+** Function name:           dmaWaitFence
+** Description:             Wait until the transfer with this fence has completed (blocking!)
+***************************************************************************************/
+void TFT_eSPI::dmaWaitFence(uint32_t fence)
+{
+  while (!dmaFenceDone(fence) && dmaBusy());
+}
+
+
+/***************************************************************************************
+** Function name:           dmaRetire
+** Description:             Stop the I2S transfer and give the bus back to the CPU
+***************************************************************************************/
+// The completion callback is called here, from dmaBusy() or dmaWait(), not an interrupt
+void TFT_eSPI::dmaRetire(void)
+{
+  I2S0.conf.tx_start = 0;
+  dmaPins(false);
+  spiBusyCheck = 0;
+
+  uint32_t fence = dmaFenceComplete + 1;
+  dmaFenceComplete = fence;
+  if (dmaDoneCb) dmaDoneCb(fence, dmaDoneArg);
+}
+
+
+/***************************************************************************************
+** Function name:           dmaPins
+** Description:             Route the data bus and WR pins to I2S (true) or GPIO (false)
+***************************************************************************************/
+void TFT_eSPI::dmaPins(bool i2s)
+{
+  const uint8_t pin[8] = { TFT_D0, TFT_D1, TFT_D2, TFT_D3, TFT_D4, TFT_D5, TFT_D6, TFT_D7 };
+
+  // An 8 bit LCD bus uses the top byte of the 24 bit I2S output
+  for (uint8_t i = 0; i < 8; i++) {
+    gpio_matrix_out(pin[i], i2s ? I2S0O_DATA_OUT16_IDX + i : SIG_GPIO_OUT_IDX, false, false);
+  }
+
+  // WR is active low so the WS clock is inverted
+  gpio_matrix_out(TFT_WR, i2s ? I2S0O_WS_OUT_IDX : SIG_GPIO_OUT_IDX, i2s, false);
+}
+
+
+/***************************************************************************************
+** Function name:           dmaStart
+** Description:             Start an I2S DMA transfer of len bytes, returns its fence
+***************************************************************************************/
+uint32_t TFT_eSPI::dmaStart(const uint8_t* data, uint32_t len, dmaDoneCallback done, void *arg)
+{
+  dmaWait(); // Only one transfer at a time as the descriptors are re-used
+
+  // Link one descriptor per DMA_I2S_DESC_LEN bytes
+  lldesc_t* desc = dmaDesc;
+  while (len)
+  {
+    uint32_t n = (len > DMA_I2S_DESC_LEN) ? DMA_I2S_DESC_LEN : len;
+    desc->size   = n;
+    desc->length = n;
+    desc->offset = 0;
+    desc->sosf   = 0;
+    desc->eof    = 0;
+    desc->owner  = 1;
+    desc->buf    = data;
+    desc->qe.stqe_next = desc + 1;
+    data += n;
+    len  -= n;
+    if (len) desc++;
+  }
+  desc->eof = 1;
+  desc->qe.stqe_next = nullptr;
+
+  DC_D;
+  dmaPins(true);
+
+  // Reset the transmitter then start the DMA, the clear of int_raw marks the transfer start
+  I2S0.conf.tx_start = 0;
+  I2S0.conf.tx_reset = 1;
+  I2S0.conf.tx_reset = 0;
+  I2S0.conf.tx_fifo_reset = 1;
+  I2S0.conf.tx_fifo_reset = 0;
+  I2S0.lc_conf.out_rst = 1;
+  I2S0.lc_conf.out_rst = 0;
+  I2S0.int_clr.val = I2S0.int_raw.val;
+
+  I2S0.out_link.addr = (uintptr_t)dmaDesc & 0xFFFFF;
+  I2S0.out_link.start = 1;
+  I2S0.conf.tx_start = 1;
+
+  dmaDoneCb  = done;
+  dmaDoneArg = arg;
+  spiBusyCheck = 1;
+
+  return ++dmaFenceQueued;
+}
+
+
+/***************************************************************************************
+** Function name:           setAddrWindowDMA
+** Description:             Set the window for pixels sent by pushPixelsDMA
+***************************************************************************************/
+// The DC line cannot be driven by the I2S peripheral, so this waits for any transfer in
+// progress and sends the window commands with the (fast) parallel CPU writes
+void TFT_eSPI::setAddrWindowDMA(int32_t x0, int32_t y0, int32_t w, int32_t h)
+{
+  setAddrWindow(x0, y0, w, h);
+}
+
+
+/***************************************************************************************
+** Function name:           pushPixelsDMA
+** Description:             Push pixels to TFT
+***************************************************************************************/
+// Native colours need no byte swap on the I2S bus, so colours in TFT byte order are swapped
+// in the original image if setSwapBytes(false) (the default) is in effect.
+uint32_t TFT_eSPI::pushPixelsDMA(uint16_t* image, uint32_t len, dmaDoneCallback done, void *arg)
+{
+  if ((len == 0) || (!DMA_Enabled)) return dmaFenceQueued;
+
+  if(!_swapBytes) {
+    dmaWait(); // The image may still be in use by the last transfer
+    for (uint32_t i = 0; i < len; i++) (image[i] = image[i] << 8 | image[i] >> 8);
+  }
+
+  const uint8_t* data = (const uint8_t*)image;
+  len <<= 1;
+
+  // Split very long pushes into transfers the descriptor list can hold
+  while (len > DMA_I2S_MAX_LEN)
+  {
+    dmaStart(data, DMA_I2S_MAX_LEN);
+    data += DMA_I2S_MAX_LEN;
+    len  -= DMA_I2S_MAX_LEN;
+  }
+
+  return dmaStart(data, len, done, arg);
+}
+
+
+/***************************************************************************************
+** Function name:           pushImageDMA
+** Description:             Push image to a window
+***************************************************************************************/
+// This will clip and also swap bytes for the I2S bus if setSwapBytes(false) is in effect
+uint32_t TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* image, uint16_t* buffer,
+                                dmaDoneCallback done, void *arg)
+{
+  if ((x >= _vpW) || (y >= _vpH) || (!DMA_Enabled)) return dmaFenceQueued;
+
+  int32_t dx = 0;
+  int32_t dy = 0;
+  int32_t dw = w;
+  int32_t dh = h;
+
+  if (x < _vpX) { dx = _vpX - x; dw -= dx; x = _vpX; }
+  if (y < _vpY) { dy = _vpY - y; dh -= dy; y = _vpY; }
+
+  if ((x + dw) > _vpW ) dw = _vpW - x;
+  if ((y + dh) > _vpH ) dh = _vpH - y;
+
+  if (dw < 1 || dh < 1) return dmaFenceQueued;
+
+  uint32_t len = dw*dh;
+  bool swap = !_swapBytes; // Native colours are sent as is on the I2S bus
+
+  if (buffer == nullptr) {
+    buffer = image;
+    dmaWait(); // The image may be changed in place
+  }
+
+  // If image is clipped, copy pixels into a contiguous block
+  if ( (dw != w) || (dh != h) ) {
+    if(swap) {
+      for (int32_t yb = 0; yb < dh; yb++) {
+        for (int32_t xb = 0; xb < dw; xb++) {
+          uint32_t src = xb + dx + w * (yb + dy);
+          (buffer[xb + yb * dw] = image[src] << 8 | image[src] >> 8);
+        }
+      }
+    }
+    else {
+      for (int32_t yb = 0; yb < dh; yb++) {
+        memmove((uint8_t*) (buffer + yb * dw), (uint8_t*) (image + dx + w * (yb + dy)), dw << 1);
+      }
+    }
+  }
+  // else, if a buffer pointer has been provided copy whole image to the buffer
+  else if (buffer != image || swap) {
+    if(swap) {
+      for (uint32_t i = 0; i < len; i++) (buffer[i] = image[i] << 8 | image[i] >> 8);
+    }
+    else {
+      memcpy(buffer, image, len*2);
+    }
+  }
+
+  setAddrWindow(x, y, dw, dh);
+
+  return dmaStart((const uint8_t*)buffer, len * 2, done, arg);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Processor specific DMA initialisation
+////////////////////////////////////////////////////////////////////////////////////////
+
+/***************************************************************************************
+** Function name:           initDMA
+** Description:             Initialise the I2S DMA engine - returns true if init OK
+***************************************************************************************/
+// Chip select is always controlled by the library for parallel displays, ctrl_cs is ignored
+bool TFT_eSPI::initDMA(bool ctrl_cs)
+{
+  if (DMA_Enabled) return false;
+  (void)ctrl_cs;
+
+  uint32_t count = (DMA_I2S_MAX_LEN + DMA_I2S_DESC_LEN - 1) / DMA_I2S_DESC_LEN;
+  dmaDesc = (lldesc_t*)heap_caps_calloc(count, sizeof(lldesc_t), MALLOC_CAP_DMA);
+  if (dmaDesc == nullptr) return false;
+
+  periph_module_enable(PERIPH_I2S0_MODULE);
+
+  I2S0.conf.val = 0;
+  I2S0.conf.tx_reset = 1;
+  I2S0.conf.tx_reset = 0;
+  I2S0.conf.tx_fifo_reset = 1;
+  I2S0.conf.tx_fifo_reset = 0;
+  I2S0.lc_conf.val = 0;
+  I2S0.lc_conf.out_rst = 1;
+  I2S0.lc_conf.out_rst = 0;
+  I2S0.lc_conf.out_eof_mode = 1;        // End of frame when data has left the FIFO
+
+  I2S0.conf2.val = 0;
+  I2S0.conf2.lcd_en = 1;                // LCD mode, WS is the write strobe
+
+  I2S0.conf.tx_right_first = 1;
+  I2S0.conf1.val = 0;
+  I2S0.conf1.tx_pcm_bypass = 1;
+  I2S0.conf1.tx_stop_en = 1;            // Stop WS when the FIFO is empty
+
+  I2S0.conf_chan.val = 0;
+  I2S0.conf_chan.tx_chan_mod = 1;       // Single channel
+
+  I2S0.fifo_conf.val = 0;
+  I2S0.fifo_conf.tx_fifo_mod_force_en = 1;
+  I2S0.fifo_conf.tx_fifo_mod = 1;       // 16 bit single channel FIFO data
+  I2S0.fifo_conf.tx_data_num = 32;
+  I2S0.fifo_conf.dscr_en = 1;           // FIFO is filled by DMA
+
+  I2S0.sample_rate_conf.val = 0;
+  I2S0.sample_rate_conf.tx_bits_mod = 8;
+  I2S0.sample_rate_conf.tx_bck_div_num = 2;
+
+  I2S0.clkm_conf.val = 0;
+  I2S0.clkm_conf.clka_en = 0;           // 80MHz PLL clock
+  I2S0.clkm_conf.clkm_div_a = 1;
+  I2S0.clkm_conf.clkm_div_b = 0;
+  I2S0.clkm_conf.clkm_div_num = TFT_I2S_CLK_DIV;
+
+  I2S0.timing.val = 0;
+  I2S0.int_ena.val = 0;
+  I2S0.int_clr.val = ~0;
+
+  DMA_Enabled = true;
+  spiBusyCheck = 0;
+  dmaFenceComplete = dmaFenceQueued; // Nothing is in flight so all fences are complete
+  return true;
+}
+
+/***************************************************************************************
+** Function name:           deInitDMA
+** Description:             Disconnect the DMA engine from the parallel bus
+***************************************************************************************/
+void TFT_eSPI::deInitDMA(void)
+{
+  if (!DMA_Enabled) return;
+  dmaWait(); // Descriptors must not be released while in use
+  periph_module_disable(PERIPH_I2S0_MODULE);
+  heap_caps_free(dmaDesc);
+  dmaDesc = nullptr;
   DMA_Enabled = false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
-#endif // End of DMA FUNCTIONS    
+#endif // End of DMA FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+#if defined (ESP32_DMA) //       DMA FUNCTIONS COMMON TO SPI AND PARALLEL
+////////////////////////////////////////////////////////////////////////////////////////
+
+/***************************************************************************************
+** Function name:           dmaFence
+** Description:             Return the fence of the most recently queued transaction
+***************************************************************************************/
+uint32_t TFT_eSPI::dmaFence(void)
+{
+  return dmaFenceQueued;
+}
+
+
+/***************************************************************************************
+** Function name:           dmaFenceDone
+** Description:             Check if the transaction with this fence has completed
+***************************************************************************************/
+bool TFT_eSPI::dmaFenceDone(uint32_t fence)
+{
+  // Difference is signed so the check still works when the fence count wraps around
+  return (int32_t)(dmaFenceComplete - fence) >= 0;
+}
+
+
+/***************************************************************************************
+** Function name:           pushBandsDMA
+** Description:             Stream a window to the TFT in bands rendered by a callback
+***************************************************************************************/
+// Two internal buffers of "lines" rows are used alternately, so the sketch callback can
+// render the next band while the previous band is being sent by DMA. The callback is
+// passed the clipped screen area it must render: x, y, width and number of lines.
+bool TFT_eSPI::pushBandsDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t lines, dmaBandCallback fill)
+{
+  if ((x >= _vpW) || (y >= _vpH) || (!DMA_Enabled) || (fill == nullptr) || (lines == 0)) return false;
+
+  if (x < _vpX) { w -= _vpX - x; x = _vpX; }
+  if (y < _vpY) { h -= _vpY - y; y = _vpY; }
+
+  if ((x + w) > _vpW ) w = _vpW - x;
+  if ((y + h) > _vpH ) h = _vpH - y;
+
+  if (w < 1 || h < 1) return false;
+
+  if (lines > h) lines = h;
+
+  // Both bands must be in DMA capable (internal) RAM
+  uint32_t bandLen = w * lines;
+  uint16_t* band[2];
+  band[0] = (uint16_t*)heap_caps_malloc(bandLen * 2, MALLOC_CAP_DMA);
+  band[1] = (uint16_t*)heap_caps_malloc(bandLen * 2, MALLOC_CAP_DMA);
+
+  if (band[0] == nullptr || band[1] == nullptr)
+  {
+    if (band[0]) heap_caps_free(band[0]);
+    if (band[1]) heap_caps_free(band[1]);
+    return false;
+  }
+
+  setAddrWindowDMA(x, y, w, h);
+
+  uint8_t  b  = 0;
+  int32_t  ye = y + h;
+
+  while (y < ye)
+  {
+    int32_t n = ye - y;
+    if (n > lines) n = lines;
+
+    // This buffer was queued two bands ago, so wait until only the other band is queued
+    dmaWaitQueue(1);
+
+    fill(band[b], x, y, w, n);
+    pushPixelsDMA(band[b], w * n);
+
+    y += n;
+    b ^= 1;
+  }
+
+  dmaWait(); // Buffers are released here so the last band must be complete
+
+  heap_caps_free(band[0]);
+  heap_caps_free(band[1]);
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+#endif // End of common DMA FUNCTIONS
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -11,6 +11,7 @@
 // Include processor specific header
 #include "soc/spi_reg.h"
 #include "driver/spi_master.h"
+#include "esp_heap_caps.h"
 
 // SUPPORT_TRANSACTIONS is mandatory for ESP32 so the hal mutex is toggled
 #if !defined (SUPPORT_TRANSACTIONS)
@@ -47,6 +48,15 @@
   #endif
 #endif
 
+// 8 bit parallel DMA uses the I2S peripheral in LCD mode, enabled by TFT_PARALLEL_DMA
+#if defined (TFT_PARALLEL_8_BIT) && defined (TFT_PARALLEL_DMA)
+  #include "soc/i2s_struct.h"
+  #include "soc/gpio_sig_map.h"
+  #include "driver/periph_ctrl.h"
+  #include "rom/lldesc.h"
+  #include "rom/gpio.h"
+#endif
+
 // Processor specific code used by SPI bus transaction startWrite and endWrite functions
 #if !defined (ESP32_PARALLEL)
   #if (TFT_SPI_MODE == SPI_MODE1) || (TFT_SPI_MODE == SPI_MODE2)
@@ -63,10 +73,51 @@
 #endif
 
 // Code to check if DMA is busy, used by SPI bus transaction transaction and endWrite functions
-#if !defined(TFT_PARALLEL_8_BIT) && !defined(SPI_18BIT_DRIVER)
+#if !defined(TFT_PARALLEL_8_BIT)
   #define ESP32_DMA
   // Code to check if DMA is busy, used by SPI DMA + transaction + endWrite functions
-  #define DMA_BUSY_CHECK  dmaWait()
+  #define DMA_BUSY_CHECK  if (spiBusyCheck) dmaWait()
+
+  // Number of DMA transactions that can be queued before a DMA push has to wait,
+  // this can be overridden in the user setup file (maximum 255). A pushImageDMA()
+  // uses 6 transactions, 5 for the window commands and 1 for the image
+  #ifndef DMA_QUEUE_SIZE
+    #define DMA_QUEUE_SIZE 12
+  #endif
+
+  // When DMA is enabled pushBlock() fills of at least DMA_FILL_MIN pixels are sent by DMA
+  // from a pre-filled buffer of DMA_FILL_BUFFER pixels, each transfer sends up to one buffer
+  #ifndef DMA_FILL_MIN
+    #define DMA_FILL_MIN 512
+  #endif
+  #ifndef DMA_FILL_BUFFER
+    #define DMA_FILL_BUFFER 2048
+  #endif
+
+  // 18 bit colour displays take 3 bytes per pixel, DMA pixels are expanded from 16 bit
+  // colours into two bounce buffers of DMA_BOUNCE_PIXELS, one is filled while the other
+  // is being sent
+  #if defined (SPI_18BIT_DRIVER)
+    #define DMA_PIXEL_BYTES 3
+    #ifndef DMA_BOUNCE_PIXELS
+      #define DMA_BOUNCE_PIXELS 1024
+    #endif
+  #else
+    #define DMA_PIXEL_BYTES 2
+  #endif
+#elif defined (TFT_PARALLEL_DMA)
+  // 8 bit parallel DMA sends one transfer at a time using the I2S peripheral
+  #define ESP32_DMA
+  #define DMA_BUSY_CHECK  if (spiBusyCheck) dmaWait()
+
+  // I2S WR strobe rate is about 80MHz / (2 * TFT_I2S_CLK_DIV), default is 10MHz
+  #ifndef TFT_I2S_CLK_DIV
+    #define TFT_I2S_CLK_DIV 4
+  #endif
+
+  // Bytes per I2S DMA descriptor (12 bit length, word aligned) and the largest transfer
+  #define DMA_I2S_DESC_LEN 4092
+  #define DMA_I2S_MAX_LEN  (TFT_WIDTH * TFT_HEIGHT * 2)
 #else
   #define DMA_BUSY_CHECK
 #endif
@@ -18,6 +18,10 @@
 
 #include "Processors/TFT_eSPI_ESP32.c"
 
+#ifdef LOAD_GLCD
+#include "Fonts/glcdfont_rows.h"
+#endif
+
 #ifndef SPI_BUSY_CHECK
 #define SPI_BUSY_CHECK
 #endif
@@ -71,6 +75,7 @@ inline void TFT_eSPI::end_tft_write(void) {
     if (!inTransaction) {      // Flag to stop ending tranaction during multiple graphics calls
         if (!locked) {          // Locked when beginTransaction has been called
             locked = true;        // Flag to show SPI access now locked
+            DMA_BUSY_CHECK;       // Queued DMA transfers must finish before CS goes high
             SPI_BUSY_CHECK;       // Check send complete and clean out unused rx data
             CS_H;
             spi.endTransaction(); //  RP2040 SDK -> 0.7us delay
@@ -78,7 +83,7 @@ inline void TFT_eSPI::end_tft_write(void) {
         SET_BUS_READ_MODE;      // In case SPI has been configured for tx only
     }
 #else
-    if(!inTransaction) {SPI_BUSY_CHECK; CS_H; SET_BUS_READ_MODE;}
+    if(!inTransaction) {DMA_BUSY_CHECK; SPI_BUSY_CHECK; CS_H; SET_BUS_READ_MODE;}
 #endif
 }
 
@@ -88,6 +93,7 @@ inline void TFT_eSPI::end_tft_write(void) {
 ***************************************************************************************/
 // Reads require a lower SPI clock rate than writes
 inline void TFT_eSPI::begin_tft_read(void) {
+    if (dlRecording) drawDisplayList(); // Reads must see the recorded drawing
     DMA_BUSY_CHECK; // Wait for any DMA transfer to complete before changing SPI settings
 #if defined (SPI_HAS_TRANSACTION) && defined (SUPPORT_TRANSACTIONS) && !defined(TFT_PARALLEL_8_BIT)
     if (locked) {
@@ -455,6 +461,8 @@ TFT_eSPI::TFT_eSPI(int16_t w, int16_t h) {
 
     addr_row = 0xFFFF;  // drawPixel command length optimiser
     addr_col = 0xFFFF;  // drawPixel command length optimiser
+    win_xe = 0xFFFF;
+    win_ye = 0xFFFF;
 
     _xPivot = 0;
     _yPivot = 0;
@@ -506,8 +514,12 @@ TFT_eSPI::TFT_eSPI(int16_t w, int16_t h) {
 ***************************************************************************************/
 void TFT_eSPI::init(SPIClass *_spi, uint8_t tc) {
     if (_booted) {
+#if !defined (TFT_PARALLEL_8_BIT)
         if (_spi != nullptr)
             spi = *_spi;
+#else
+        (void)_spi;
+#endif
 
         lockTransaction = false;
         inTransaction = false;
@@ -536,6 +548,13 @@ void TFT_eSPI::init(SPIClass *_spi, uint8_t tc) {
 
     delay(150); // Wait for reset to complete
 
+    // The reset leaves the TFT window unknown, so the next window is always sent. This is
+    // done here as the driver initialisation code may return from init()
+    addr_row = 0xFFFF;
+    addr_col = 0xFFFF;
+    win_xe = 0xFFFF;
+    win_ye = 0xFFFF;
+
     begin_tft_write();
 
     tc = tc; // Supress warning
@@ -634,8 +653,16 @@ void TFT_eSPI::spiwrite(uint8_t c) {
 ** Description:             Send an 8 bit command to the TFT
 ***************************************************************************************/
 void TFT_eSPI::writecommand(uint8_t c) {
+    if (dlRecording) drawDisplayList(); // Commands such as rotation apply after the list
+
+    // The window cache no longer matches the TFT, so setWindow() must resend it
+    if (c == TFT_CASET) addr_col = 0xFFFF;
+    if (c == TFT_PASET) addr_row = 0xFFFF;
+
     begin_tft_write();
 
+    DMA_BUSY_CHECK;
+
     DC_C;
 
     tft_Write_8(c);
@@ -654,6 +681,8 @@ void TFT_eSPI::writecommand(uint8_t c) {
 void TFT_eSPI::writedata(uint8_t d) {
     begin_tft_write();
 
+    DMA_BUSY_CHECK;
+
     DC_D;        // Play safe, but should already be in data mode
 
     tft_Write_8(d);
@@ -1607,23 +1636,28 @@ void TFT_eSPI::drawCircleHelper(int32_t x0, int32_t y0, int32_t rr, uint8_t corn
 ** Description:             draw a filled circle
 ***************************************************************************************/
 // Optimised midpoint circle algorithm, changed to horizontal lines (faster in sprites)
-// Improved algorithm avoids repetition of lines
+// Improved algorithm avoids repetition of lines. The rows are collected in a span table
+// and drawn top to bottom, so rows of the same width are merged into one rectangle
 void TFT_eSPI::fillCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color) {
+    int32_t ys = y0 - r, ye = y0 + r;
+    if ((r < 0) || !clipSpanRows(ys, ye)) return;
+
+    int32_t hw[ye - ys + 1];
+    spanTable t = {ys, ye - ys + 1, hw};
+    clearSpans(t);
+
     int32_t x = 0;
     int32_t dx = 1;
     int32_t dy = r + r;
     int32_t p = -(r >> 1);
 
-    //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
-    inTransaction = true;
-
-    drawFastHLine(x0 - r, y0, dy + 1, color);
+    addSpan(t, y0, r);
 
     while (x < r) {
 
         if (p >= 0) {
-            drawFastHLine(x0 - x, y0 + r, dx, color);
-            drawFastHLine(x0 - x, y0 - r, dx, color);
+            addSpan(t, y0 + r, x);
+            addSpan(t, y0 - r, x);
             dy -= 2;
             p -= dy;
             r--;
@@ -1633,13 +1667,12 @@ void TFT_eSPI::fillCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color) {
         p += dx;
         x++;
 
-        drawFastHLine(x0 - r, y0 + x, dy + 1, color);
-        drawFastHLine(x0 - r, y0 - x, dy + 1, color);
+        addSpan(t, y0 + x, r);
+        addSpan(t, y0 - x, r);
 
     }
 
-    inTransaction = lockTransaction;
-    end_tft_write();              // Does nothing if Sprite class uses this function
+    drawSpans(t, x0, x0, color);
 }
 
 /***************************************************************************************
@@ -1731,6 +1764,14 @@ void TFT_eSPI::drawEllipse(int16_t x0, int16_t y0, int32_t rx, int32_t ry, uint1
 void TFT_eSPI::fillEllipse(int16_t x0, int16_t y0, int32_t rx, int32_t ry, uint16_t color) {
     if (rx < 2) return;
     if (ry < 2) return;
+
+    int32_t ys = y0 - ry, ye = y0 + ry;
+    if (!clipSpanRows(ys, ye)) return;
+
+    int32_t hw[ye - ys + 1];
+    spanTable t = {ys, ye - ys + 1, hw};
+    clearSpans(t);
+
     int32_t x, y;
     int32_t rx2 = rx * rx;
     int32_t ry2 = ry * ry;
@@ -1738,12 +1779,9 @@ void TFT_eSPI::fillEllipse(int16_t x0, int16_t y0, int32_t rx, int32_t ry, uint1
     int32_t fy2 = 4 * ry2;
     int32_t s;
 
-    //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
-    inTransaction = true;
-
     for (x = 0, y = ry, s = 2 * ry2 + rx2 * (1 - 2 * ry); ry2 * x <= rx2 * y; x++) {
-        drawFastHLine(x0 - x, y0 - y, x + x + 1, color);
-        drawFastHLine(x0 - x, y0 + y, x + x + 1, color);
+        addSpan(t, y0 - y, x);
+        addSpan(t, y0 + y, x);
 
         if (s >= 0) {
             s += fx2 * (1 - y);
@@ -1753,8 +1791,8 @@ void TFT_eSPI::fillEllipse(int16_t x0, int16_t y0, int32_t rx, int32_t ry, uint1
     }
 
     for (x = rx, y = 0, s = 2 * rx2 + ry2 * (1 - 2 * rx); rx2 * y <= ry2 * x; y++) {
-        drawFastHLine(x0 - x, y0 - y, x + x + 1, color);
-        drawFastHLine(x0 - x, y0 + y, x + x + 1, color);
+        addSpan(t, y0 - y, x);
+        addSpan(t, y0 + y, x);
 
         if (s >= 0) {
             s += fy2 * (1 - x);
@@ -1763,8 +1801,7 @@ void TFT_eSPI::fillEllipse(int16_t x0, int16_t y0, int32_t rx, int32_t ry, uint1
         s += rx2 * ((4 * y) + 6);
     }
 
-    inTransaction = lockTransaction;
-    end_tft_write();              // Does nothing if Sprite class uses this function
+    drawSpans(t, x0, x0, color);
 }
 
 
@@ -1826,20 +1863,50 @@ void TFT_eSPI::drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t
 ** Function name:           fillRoundRect
 ** Description:             Draw a rounded corner filled rectangle
 ***************************************************************************************/
-// Fill a rounded rectangle, changed to horizontal lines (faster in sprites)
+// Fill a rounded rectangle, changed to horizontal lines (faster in sprites). Each row spans
+// the straight edges x + r to x + w - r - 1 plus a half width either side: r for the middle
+// rows, or from the fillCircleHelper() corner algorithm for the top and bottom rows
 void TFT_eSPI::fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color) {
-    //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
-    inTransaction = true;
+    if (r < 0) r = 0;
 
-    // smarter version
-    fillRect(x, y + r, w, h - r - r, color);
+    // Corner rows reach past the top and bottom edges if r is over the height
+    int32_t ys = (r > h) ? y + h - r : y;
+    int32_t ye = (r > h) ? y + r - 1 : y + h - 1;
+    if (!clipSpanRows(ys, ye)) return;
 
-    // draw four corners
-    fillCircleHelper(x + r, y + h - r - 1, r, 1, w - r - r - 1, color);
-    fillCircleHelper(x + r, y + r, r, 2, w - r - r - 1, color);
+    int32_t hw[ye - ys + 1];
+    spanTable t = {ys, ye - ys + 1, hw};
+    clearSpans(t);
 
-    inTransaction = lockTransaction;
-    end_tft_write();              // Does nothing if Sprite class uses this function
+    // Centre rows and the span between the corner centres
+    int32_t yt = y + r, yb = y + h - r - 1;
+    int32_t xl = x + r, xr = x + w - r - 1;
+
+    for (int32_t yy = (yt > ys) ? yt : ys; yy <= yb && yy <= ye; yy++) addSpan(t, yy, r);
+
+    int32_t f = 1 - r;
+    int32_t ddF_x = 1;
+    int32_t ddF_y = -r - r;
+    int32_t i = 0;
+
+    while (i < r) {
+        if (f >= 0) {
+            addSpan(t, yb + r, i);
+            addSpan(t, yt - r, i);
+            r--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+
+        i++;
+        ddF_x += 2;
+        f += ddF_x;
+
+        addSpan(t, yb + i, r);
+        addSpan(t, yt - i, r);
+    }
+
+    drawSpans(t, xl, xr, color);
 }
 
 
@@ -1865,147 +1932,183 @@ void TFT_eSPI::drawTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int3
 ** Function name:           fillTriangle
 ** Description:             Draw a filled triangle using 3 arbitrary points
 ***************************************************************************************/
-// Fill a triangle - original Adafruit function works well and code footprint is small
 void TFT_eSPI::fillTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint32_t color) {
-    int32_t a, b, y, last;
+    int32_t x[3] = {x0, x1, x2};
+    int32_t y[3] = {y0, y1, y2};
 
-    // Sort coordinates by Y order (y2 >= y1 >= y0)
-    if (y0 > y1) {
-        swap_coord(y0, y1);
-        swap_coord(x0, x1);
-    }
-    if (y1 > y2) {
-        swap_coord(y2, y1);
-        swap_coord(x2, x1);
-    }
-    if (y0 > y1) {
-        swap_coord(y0, y1);
-        swap_coord(x0, x1);
-    }
+    fillPolygon(x, y, 3, color);
+}
 
-    if (y0 == y2) { // Handle awkward all-on-same-line case as its own thing
-        a = b = x0;
-        if (x1 < a) a = x1;
-        else if (x1 > b) b = x1;
-        if (x2 < a) a = x2;
-        else if (x2 > b) b = x2;
-        drawFastHLine(a, y0, b - a + 1, color);
-        return;
-    }
 
-    //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
-    inTransaction = true;
+// Polygon edge from its top corner, x on row k is xt + (k * dx) / dy rounded towards 0 as
+// the original Adafruit triangle fill, stepped a row at a time without a division
+typedef struct {
+    int32_t yt, yb;  // Top row and last row (yb is included only at a bottom corner)
+    int32_t x;       // x on the current row
+    int32_t step;    // Whole pixels added per row
+    int32_t rem;     // Remainder carried, has the sign of dx
+    int32_t inc;     // Remainder added per row
+    int32_t dy;
+} polyEdge;
 
-    int32_t
-            dx01 = x1 - x0,
-            dy01 = y1 - y0,
-            dx02 = x2 - x0,
-            dy02 = y2 - y0,
-            dx12 = x2 - x1,
-            dy12 = y2 - y1,
-            sa = 0,
-            sb = 0;
-
-    // For upper part of triangle, find scanline crossings for segments
-    // 0-1 and 0-2.  If y1=y2 (flat-bottomed triangle), the scanline y1
-    // is included here (and second loop will be skipped, avoiding a /0
-    // error there), otherwise scanline y1 is skipped here and handled
-    // in the second loop...which also avoids a /0 error here if y0=y1
-    // (flat-topped triangle).
-    if (y1 == y2) last = y1;  // Include y1 scanline
-    else last = y1 - 1; // Skip it
-
-    for (y = y0; y <= last; y++) {
-        a = x0 + sa / dy01;
-        b = x0 + sb / dy02;
-        sa += dx01;
-        sb += dx02;
-
-        if (a > b) swap_coord(a, b);
-        drawFastHLine(a, y, b - a + 1, color);
-    }
+static void edgeStart(polyEdge *e, int32_t xt, int32_t dx, int32_t dy, int32_t k) {
+    e->dy = dy;
+    e->step = dx / dy;
+    e->inc = dx % dy;
+    e->x = xt + (k * dx) / dy; // Start k rows down if the top is clipped
+    e->rem = (k * dx) % dy;
+}
 
-    // For lower part of triangle, find scanline crossings for segments
-    // 0-2 and 1-2.  This loop is skipped if y1=y2.
-    sa = dx12 * (y - y1);
-    sb = dx02 * (y - y0);
-    for (; y <= y2; y++) {
-        a = x1 + sa / dy12;
-        b = x0 + sb / dy02;
-        sa += dx12;
-        sb += dx02;
-
-        if (a > b) swap_coord(a, b);
-        drawFastHLine(a, y, b - a + 1, color);
+static inline void edgeStep(polyEdge *e) {
+    e->x += e->step;
+    e->rem += e->inc;
+    if (e->inc >= 0) {
+        if (e->rem >= e->dy) { e->rem -= e->dy; e->x++; }
     }
-
-    inTransaction = lockTransaction;
-    end_tft_write();              // Does nothing if Sprite class uses this function
+    else if (e->rem <= -e->dy) { e->rem += e->dy; e->x--; }
 }
 
 
 /***************************************************************************************
-** Function name:           drawBitmap
-** Description:             Draw an image stored in an array on the TFT
+** Function name:           fillPolygon
+** Description:             Draw a filled polygon, edge crossings use the even-odd rule
 ***************************************************************************************/
-void TFT_eSPI::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color) {
+// Each edge covers its rows from the top corner down to (but not including) the bottom
+// corner, unless the bottom corner is a lowest point of the outline. Pixels between pairs
+// of edges are filled, including the edge pixels, so triangles match the Adafruit fill
+void TFT_eSPI::fillPolygon(const int32_t *x, const int32_t *y, uint16_t n, uint32_t color) {
+    if (_vpOoB || (n < 3)) return;
+
+    int32_t ymin = y[0], ymax = y[0];
+    for (uint16_t i = 1; i < n; i++) {
+        if (y[i] < ymin) ymin = y[i];
+        if (y[i] > ymax) ymax = y[i];
+    }
+
     //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
     inTransaction = true;
 
-    int32_t i, j, byteWidth = (w + 7) / 8;
+    if (ymin == ymax) { // All corners on one line
+        int32_t a = x[0], b = x[0];
+        for (uint16_t i = 1; i < n; i++) {
+            if (x[i] < a) a = x[i];
+            if (x[i] > b) b = x[i];
+        }
+        drawFastHLine(a, ymin, b - a + 1, color);
+        inTransaction = lockTransaction;
+        end_tft_write();
+        return;
+    }
 
-    for (j = 0; j < h; j++) {
-        for (i = 0; i < w; i++) {
-            if (pgm_read_byte(bitmap + j * byteWidth + i / 8) & (128 >> (i & 7))) {
-                drawPixel(x + i, y + j, color);
-            }
+    // Rows inside the viewport
+    int32_t yStart = ymin, yEnd = ymax;
+    if (yStart < _vpY - _yDatum) yStart = _vpY - _yDatum;
+    if (yEnd >= _vpH - _yDatum) yEnd = _vpH - _yDatum - 1;
+
+    // Edge, crossing and span tables, the corner count is set by the caller so large
+    // polygons use the heap
+    polyEdge stackEdge[POLYGON_STACK_CORNERS];
+    int32_t  stackTable[POLYGON_STACK_CORNERS * 8 + 1];
+    polyEdge *edge = stackEdge;
+    int32_t  *table = stackTable;
+    uint8_t  *heap = nullptr;
+
+    if (n > POLYGON_STACK_CORNERS) {
+        heap = (uint8_t *) malloc(n * sizeof(polyEdge) + (n * 8 + 1) * sizeof(int32_t));
+        if (!heap) {
+            inTransaction = lockTransaction;
+            end_tft_write();
+            return;
         }
+        edge = (polyEdge *) heap;
+        table = (int32_t *) (heap + n * sizeof(polyEdge));
     }
 
-    inTransaction = lockTransaction;
-    end_tft_write();              // Does nothing if Sprite class uses this function
-}
+    uint16_t edges = 0;
+    int32_t  (*flatX)[2] = (int32_t (*)[2]) table; // Horizontal edges are filled on their row as well
+    int32_t  *flatY = table + 2 * n;
+    uint16_t flats = 0;
 
+    for (uint16_t i = 0; i < n; i++) {
+        uint16_t j = (i + 1 < n) ? i + 1 : 0;
 
-/***************************************************************************************
-** Function name:           drawBitmap
-** Description:             Draw an image stored in an array on the TFT
-***************************************************************************************/
-void TFT_eSPI::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t fgcolor, uint16_t bgcolor) {
-    //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
-    inTransaction = true;
+        if (y[i] == y[j]) {
+            flatX[flats][0] = (x[i] < x[j]) ? x[i] : x[j];
+            flatX[flats][1] = (x[i] < x[j]) ? x[j] : x[i];
+            flatY[flats++] = y[i];
+            continue;
+        }
 
-    int32_t i, j, byteWidth = (w + 7) / 8;
+        // Orient top to bottom, then look past any horizontal edges at the bottom corner
+        // to see if the outline turns back up there
+        uint16_t t = i, b = j;
+        int16_t dir = 1;
+        if (y[i] > y[j]) { t = j; b = i; dir = -1; }
 
-    for (j = 0; j < h; j++) {
-        for (i = 0; i < w; i++) {
-            if (pgm_read_byte(bitmap + j * byteWidth + i / 8) & (128 >> (i & 7)))
-                drawPixel(x + i, y + j, fgcolor);
-            else drawPixel(x + i, y + j, bgcolor);
-        }
-    }
+        uint16_t c = b;
+        do {
+            c = (dir > 0) ? ((c + 1 < n) ? c + 1 : 0) : (c ? c - 1 : n - 1);
+        } while ((y[c] == y[b]) && (c != b));
 
-    inTransaction = lockTransaction;
-    end_tft_write();              // Does nothing if Sprite class uses this function
-}
+        polyEdge *e = &edge[edges++];
+        e->yt = y[t];
+        e->yb = (y[c] < y[b]) ? y[b] : y[b] - 1; // Include the bottom row at a lowest point
 
-/***************************************************************************************
-** Function name:           drawXBitmap
-** Description:             Draw an image stored in an XBM array onto the TFT
-***************************************************************************************/
-void TFT_eSPI::drawXBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color) {
-    //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
-    inTransaction = true;
+        int32_t skip = (yStart > e->yt) ? yStart - e->yt : 0;
+        edgeStart(e, x[t], x[b] - x[t], y[b] - y[t], skip);
+        if (skip) e->yt = yStart;
+    }
 
-    int32_t i, j, byteWidth = (w + 7) / 8;
+    int32_t  *cross = flatY + n;                          // n + 1 entries
+    int32_t  (*span)[2] = (int32_t (*)[2]) (cross + n + 1); // n + n entries
+    spanRun  run = {0, 0, 0, 0};
+
+    for (int32_t yy = yStart; yy <= yEnd; yy++) {
+        // x of each edge crossing this row, in order
+        uint16_t count = 0;
+        for (uint16_t i = 0; i < edges; i++) {
+            polyEdge *e = &edge[i];
+            if ((yy < e->yt) || (yy > e->yb)) continue;
+            int32_t cx = e->x;
+            uint16_t m = count++;
+            while (m && (cross[m - 1] > cx)) { cross[m] = cross[m - 1]; m--; }
+            cross[m] = cx;
+            edgeStep(e);
+        }
 
-    for (j = 0; j < h; j++) {
-        for (i = 0; i < w; i++) {
-            if (pgm_read_byte(bitmap + j * byteWidth + i / 8) & (1 << (i & 7))) {
-                drawPixel(x + i, y + j, color);
+        // Pairs of crossings plus horizontal edges on this row, sorted and merged
+        uint16_t spans = 0;
+        for (uint16_t i = 0; i + 1 < count; i += 2) {
+            span[spans][0] = cross[i];
+            span[spans++][1] = cross[i + 1];
+        }
+        for (uint16_t i = 0; i < flats; i++) {
+            if (flatY[i] != yy) continue;
+            uint16_t m = spans++;
+            while (m && (span[m - 1][0] > flatX[i][0])) { span[m][0] = span[m - 1][0]; span[m][1] = span[m - 1][1]; m--; }
+            span[m][0] = flatX[i][0];
+            span[m][1] = flatX[i][1];
+        }
+
+        uint16_t merged = 0;
+        for (uint16_t i = 0; i < spans; i++) {
+            if (merged && (span[i][0] <= span[merged - 1][1] + 1)) {
+                if (span[i][1] > span[merged - 1][1]) span[merged - 1][1] = span[i][1];
             }
+            else {
+                span[merged][0] = span[i][0];
+                span[merged++][1] = span[i][1];
+            }
+        }
+
+        if (merged == 1) pushSpan(run, span[0][0], span[0][1], yy, color);
+        else {
+            pushSpan(run, 0, -1, yy, color); // Flush
+            for (uint16_t i = 0; i < merged; i++) drawFastHLine(span[i][0], yy, span[i][1] - span[i][0] + 1, color);
         }
     }
+    pushSpan(run, 0, -1, yEnd + 1, color); // Flush
+    if (heap) free(heap);
 
     inTransaction = lockTransaction;
     end_tft_write();              // Does nothing if Sprite class uses this function
@@ -2013,158 +2116,832 @@ void TFT_eSPI::drawXBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t
 
 
 /***************************************************************************************
-** Function name:           drawXBitmap
-** Description:             Draw an XBM image with foreground and background colors
+** Function name:           pushSpan
+** Description:             Add a polygon row span, rows with the same span are batched
 ***************************************************************************************/
-void TFT_eSPI::drawXBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bgcolor) {
-    //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
-    inTransaction = true;
-
-    int32_t i, j, byteWidth = (w + 7) / 8;
+// A span with x1 < x0 draws the rows batched so far
+void TFT_eSPI::pushSpan(spanRun &run, int32_t x0, int32_t x1, int32_t y, uint32_t color) {
+    if (run.h && (x0 == run.x0) && (x1 == run.x1) && (y == run.y + run.h)) {
+        run.h++;
+        return;
+    }
 
-    for (j = 0; j < h; j++) {
-        for (i = 0; i < w; i++) {
-            if (pgm_read_byte(bitmap + j * byteWidth + i / 8) & (1 << (i & 7)))
-                drawPixel(x + i, y + j, color);
-            else drawPixel(x + i, y + j, bgcolor);
-        }
+    if (run.h) {
+        if (run.h == 1) drawFastHLine(run.x0, run.y, run.x1 - run.x0 + 1, color);
+        else fillRect(run.x0, run.y, run.x1 - run.x0 + 1, run.h, color);
     }
 
-    inTransaction = lockTransaction;
-    end_tft_write();              // Does nothing if Sprite class uses this function
+    run.x0 = x0;
+    run.x1 = x1;
+    run.y = y;
+    run.h = (x1 >= x0) ? 1 : 0;
 }
 
 
 /***************************************************************************************
-** Function name:           setCursor
-** Description:             Set the text cursor x,y position
+** Function name:           clipSpanRows
+** Description:             Clip the rows ys to ye of a span table to the viewport
 ***************************************************************************************/
-void TFT_eSPI::setCursor(int16_t x, int16_t y) {
-    cursor_x = x;
-    cursor_y = y;
+// Returns false if no rows are visible
+bool TFT_eSPI::clipSpanRows(int32_t &ys, int32_t &ye) {
+    if (_vpOoB) return false;
+
+    if (ys < _vpY - _yDatum) ys = _vpY - _yDatum;
+    if (ye >= _vpH - _yDatum) ye = _vpH - _yDatum - 1;
+
+    return ys <= ye;
 }
 
 
+#define SPAN_EMPTY (-0x3FFFFFFF) // Half width of a row with nothing to draw
+
 /***************************************************************************************
-** Function name:           setCursor
-** Description:             Set the text cursor x,y position and font
+** Function name:           clearSpans
+** Description:             Mark all rows of a span table as empty
 ***************************************************************************************/
-void TFT_eSPI::setCursor(int16_t x, int16_t y, uint8_t font) {
-    textfont = font;
-    cursor_x = x;
-    cursor_y = y;
+void TFT_eSPI::clearSpans(spanTable &t) {
+    for (int32_t i = 0; i < t.rows; i++) t.hw[i] = SPAN_EMPTY;
 }
 
 
 /***************************************************************************************
-** Function name:           getCursorX
-** Description:             Get the text cursor x position
+** Function name:           addSpan
+** Description:             Add a row span to a span table, rows off the table are ignored
 ***************************************************************************************/
-int16_t TFT_eSPI::getCursorX(void) {
-    return cursor_x;
+inline void TFT_eSPI::addSpan(spanTable &t, int32_t y, int32_t hw) {
+    y -= t.y0;
+    if ((y >= 0) && (y < t.rows) && (hw > t.hw[y])) t.hw[y] = hw;
 }
 
+
 /***************************************************************************************
-** Function name:           getCursorY
-** Description:             Get the text cursor y position
+** Function name:           drawSpans
+** Description:             Draw the rows of a span table from top to bottom
 ***************************************************************************************/
-int16_t TFT_eSPI::getCursorY(void) {
-    return cursor_y;
+// Row i spans xl - hw[i] to xr + hw[i]. Spans are clipped to the viewport first, so rows
+// wider than the viewport also merge into one rectangle
+void TFT_eSPI::drawSpans(const spanTable &t, int32_t xl, int32_t xr, uint32_t color) {
+    int32_t vx0 = _vpX - _xDatum, vx1 = _vpW - _xDatum - 1;
+
+    //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
+    inTransaction = true;
+
+    spanRun run = {0, 0, 0, 0};
+    for (int32_t i = 0; i < t.rows; i++) {
+        int32_t x0 = xl - t.hw[i], x1 = xr + t.hw[i];
+        if (x0 < vx0) x0 = vx0;
+        if (x1 > vx1) x1 = vx1;
+        pushSpan(run, x0, x1, t.y0 + i, color); // x1 < x0 flushes an empty row
+    }
+    pushSpan(run, 0, -1, t.y0 + t.rows, color); // Flush
+
+    inTransaction = lockTransaction;
+    end_tft_write();              // Does nothing if Sprite class uses this function
 }
 
 
 /***************************************************************************************
-** Function name:           setTextSize
-** Description:             Set the text size multiplier
+** Function name:           drawPixel (alpha blended)
+** Description:             Draw a pixel blended with the background, returns colour
 ***************************************************************************************/
-void TFT_eSPI::setTextSize(uint8_t s) {
-    if (s > 7) s = 7; // Limit the maximum size multiplier so byte variables can be used for rendering
-    textsize = (s > 0) ? s : 1; // Don't allow font size 0
+// If bg_color is omitted the background is read from the TFT or Sprite
+uint16_t TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color, uint8_t alpha, uint32_t bg_color) {
+    if (bg_color == 0x00FFFFFF) bg_color = readPixel(x, y);
+    color = alphaBlend(alpha, color, bg_color);
+    drawPixel(x, y, color);
+    return color;
 }
 
 
 /***************************************************************************************
-** Function name:           setTextColor
-** Description:             Set the font foreground colour (background is transparent)
+** Function name:           drawSmoothLine
+** Description:             Draw an anti-aliased 1 pixel wide line (Xiaolin Wu)
 ***************************************************************************************/
-void TFT_eSPI::setTextColor(uint16_t c) {
-    // For 'transparent' background, we'll set the bg
-    // to the same as fg instead of using a flag
-    textcolor = textbgcolor = c;
+// Each step along the line covers two pixels across it. These are collected in two runs
+// that follow the line, so a shallow line is drawn as a few row segments, not pixels
+void TFT_eSPI::drawSmoothLine(float ax, float ay, float bx, float by, uint32_t fg_color, uint32_t bg_color) {
+    if (_vpOoB) return;
+
+    bool steep = fabsf(by - ay) > fabsf(bx - ax);
+    if (steep) { swap_coord(ax, ay); swap_coord(bx, by); }
+    if (ax > bx) { swap_coord(ax, bx); swap_coord(ay, by); }
+
+    float grad = (bx > ax) ? (by - ay) / (bx - ax) : 0;
+
+    // End columns are weighted by how much of them the line covers
+    int32_t xs = floorf(ax + 0.5f), xe = floorf(bx + 0.5f);
+    float   ws = xs + 0.5f - ax, we = bx + 0.5f - xe;
+    if (xs == xe) ws = we = bx - ax;
+
+    // Steps inside the viewport
+    int32_t x0 = xs, x1 = xe;
+    int32_t lo = steep ? _vpY - _yDatum : _vpX - _xDatum;
+    int32_t hi = steep ? _vpH - _yDatum : _vpW - _xDatum;
+    if (x0 < lo) x0 = lo;
+    if (x1 >= hi) x1 = hi - 1;
+    if (x0 > x1) return;
+
+    //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
+    inTransaction = true;
+
+    alphaRun run[2]; // run[side] is on the lower pixel across the line
+    run[0].n = run[1].n = 0;
+    run[0].vertical = run[1].vertical = steep;
+    uint8_t side = 0;
+    int32_t last = 0;
+
+    for (int32_t x = x0; x <= x1; x++) {
+        float   y  = ay + grad * (x - ax);
+        int32_t yi = floorf(y);
+        float   f  = y - yi;
+        float   w  = (x == xs) ? ws : (x == xe) ? we : 1.0f;
+
+        // One run is left behind when the line moves across a pixel, the other carries on
+        if ((x > x0) && (yi != last)) {
+            if (yi == last + 1) pushAlphaRun(run[side], fg_color, bg_color);
+            else if (yi == last - 1) pushAlphaRun(run[side ^ 1], fg_color, bg_color);
+            else {
+                pushAlphaRun(run[0], fg_color, bg_color);
+                pushAlphaRun(run[1], fg_color, bg_color);
+            }
+            side ^= 1;
+        }
+        last = yi;
+
+        uint8_t a0 = (1.0f - f) * w * 255.0f + 0.5f;
+        uint8_t a1 = f * w * 255.0f + 0.5f;
+        if (steep) {
+            addAlpha(run[side], yi, x, a0, fg_color, bg_color);
+            addAlpha(run[side ^ 1], yi + 1, x, a1, fg_color, bg_color);
+        }
+        else {
+            addAlpha(run[side], x, yi, a0, fg_color, bg_color);
+            addAlpha(run[side ^ 1], x, yi + 1, a1, fg_color, bg_color);
+        }
+    }
+    pushAlphaRun(run[0], fg_color, bg_color);
+    pushAlphaRun(run[1], fg_color, bg_color);
+
+    inTransaction = lockTransaction;
+    end_tft_write();              // Does nothing if Sprite class uses this function
 }
 
 
 /***************************************************************************************
-** Function name:           setTextColor
-** Description:             Set the font foreground and background colour
+** Function name:           drawWideLine
+** Description:             Draw an anti-aliased line of width wd with round ends
 ***************************************************************************************/
-void TFT_eSPI::setTextColor(uint16_t c, uint16_t b) {
-    textcolor = c;
-    textbgcolor = b;
+void TFT_eSPI::drawWideLine(float ax, float ay, float bx, float by, float wd, uint32_t fg_color, uint32_t bg_color) {
+    drawWedgeLine(ax, ay, bx, by, wd / 2.0f, wd / 2.0f, fg_color, bg_color);
 }
 
 
 /***************************************************************************************
-** Function name:           setPivot
-** Description:             Set the pivot point on the TFT
-*************************************************************************************x*/
-void TFT_eSPI::setPivot(int16_t x, int16_t y) {
-    _xPivot = x;
-    _yPivot = y;
+** Function name:           drawWedgeLine
+** Description:             Draw an anti-aliased line tapering from radius ar to br
+***************************************************************************************/
+void TFT_eSPI::drawWedgeLine(float ax, float ay, float bx, float by, float ar, float br, uint32_t fg_color, uint32_t bg_color) {
+    if (ar < 0) ar = 0;
+    if (br < 0) br = 0;
+
+    aaShape s;
+    s.type = aaWedge;
+    s.x = ax; s.y = ay;
+    s.r0 = ar; s.r1 = br;
+    s.ux = bx - ax; s.uy = by - ay;
+    s.h = s.ux * s.ux + s.uy * s.uy;
+
+    float b = ar - br;
+    if (s.h <= b * b) { // One end circle is inside the other
+        if (br > ar) { s.x = bx; s.y = by; s.r0 = br; }
+        s.h = 0;
+    }
+    else {
+        s.vx = sqrtf(s.h - b * b); // Side tangent
+        s.vy = b;
+    }
+
+    float r = (ar > br) ? ar : br;
+    s.x0 = floorf(((ax < bx) ? ax : bx) - r);
+    s.x1 = ceilf(((ax > bx) ? ax : bx) + r);
+    s.y0 = floorf(((ay < by) ? ay : by) - r);
+    s.y1 = ceilf(((ay > by) ? ay : by) + r);
+
+    drawSmoothShape(s, fg_color, bg_color);
 }
 
 
 /***************************************************************************************
-** Function name:           getPivotX
-** Description:             Get the x pivot position
+** Function name:           drawSpot
+** Description:             Draw an anti-aliased filled circle at a sub-pixel position
 ***************************************************************************************/
-int16_t TFT_eSPI::getPivotX(void) {
-    return _xPivot;
+void TFT_eSPI::drawSpot(float ax, float ay, float r, uint32_t fg_color, uint32_t bg_color) {
+    drawWedgeLine(ax, ay, ax, ay, r, r, fg_color, bg_color);
 }
 
 
 /***************************************************************************************
-** Function name:           getPivotY
-** Description:             Get the y pivot position
+** Function name:           drawSmoothCircle
+** Description:             Draw an anti-aliased circle outline
 ***************************************************************************************/
-int16_t TFT_eSPI::getPivotY(void) {
-    return _yPivot;
+void TFT_eSPI::drawSmoothCircle(int32_t x, int32_t y, int32_t r, uint32_t fg_color, uint32_t bg_color) {
+    drawSmoothArc(x, y, r, r, 0, 360, fg_color, bg_color);
 }
 
 
 /***************************************************************************************
-** Function name:           setBitmapColor
-** Description:             Set the foreground foreground and background colour
+** Function name:           fillSmoothCircle
+** Description:             Draw an anti-aliased filled circle
 ***************************************************************************************/
-void TFT_eSPI::setBitmapColor(uint16_t c, uint16_t b) {
-    if (c == b) b = ~c;
-    bitmap_fg = c;
-    bitmap_bg = b;
+void TFT_eSPI::fillSmoothCircle(int32_t x, int32_t y, int32_t r, uint32_t color, uint32_t bg_color) {
+    if (r < 0) return;
+    drawWedgeLine(x, y, x, y, r + 0.5f, r + 0.5f, color, bg_color);
 }
 
 
 /***************************************************************************************
-** Function name:           setTextWrap
-** Description:             Define if text should wrap at end of line
+** Function name:           drawSmoothEllipse
+** Description:             Draw an anti-aliased ellipse outline
 ***************************************************************************************/
-void TFT_eSPI::setTextWrap(bool wrapX, bool wrapY) {
-    textwrapX = wrapX;
-    textwrapY = wrapY;
+// The outline is the ring between ellipses half a pixel outside and inside the one drawn
+// by drawEllipse(), it is filled if the inner ellipse has no area
+void TFT_eSPI::drawSmoothEllipse(int32_t x, int32_t y, int32_t rx, int32_t ry, uint32_t fg_color, uint32_t bg_color) {
+    if ((rx < 0) || (ry < 0)) return;
+
+    aaShape s;
+    s.type = aaEllipse;
+    s.x = x; s.y = y;
+    s.r0 = rx + 0.5f; s.r1 = ry + 0.5f;
+    s.ux = rx - 0.5f; s.uy = ry - 0.5f;
+    s.full = (s.ux <= 0) || (s.uy <= 0);
+
+    s.x0 = x - rx - 1; s.x1 = x + rx + 1;
+    s.y0 = y - ry - 1; s.y1 = y + ry + 1;
+
+    drawSmoothShape(s, fg_color, bg_color);
 }
 
 
 /***************************************************************************************
-** Function name:           setTextDatum
-** Description:             Set the text position reference datum
+** Function name:           fillSmoothEllipse
+** Description:             Draw an anti-aliased filled ellipse
 ***************************************************************************************/
-void TFT_eSPI::setTextDatum(uint8_t d) {
-    textdatum = d;
+void TFT_eSPI::fillSmoothEllipse(int32_t x, int32_t y, int32_t rx, int32_t ry, uint32_t color, uint32_t bg_color) {
+    if ((rx < 0) || (ry < 0)) return;
+
+    aaShape s;
+    s.type = aaEllipse;
+    s.full = true;
+    s.x = x; s.y = y;
+    s.r0 = rx + 0.5f; s.r1 = ry + 0.5f;
+
+    s.x0 = x - rx - 1; s.x1 = x + rx + 1;
+    s.y0 = y - ry - 1; s.y1 = y + ry + 1;
+
+    drawSmoothShape(s, color, bg_color);
 }
 
 
 /***************************************************************************************
-** Function name:           setTextPadding
-** Description:             Define padding width (aids erasing old text and numbers)
+** Function name:           drawSmoothArc
+** Description:             Draw an anti-aliased arc clockwise from startAngle to endAngle
+***************************************************************************************/
+void TFT_eSPI::drawSmoothArc(int32_t x, int32_t y, int32_t r, int32_t ir, uint32_t startAngle, uint32_t endAngle,
+                             uint32_t fg_color, uint32_t bg_color, bool roundEnds) {
+    if (startAngle > 360) startAngle = 360;
+    if (endAngle > 360) endAngle = 360;
+    if ((startAngle == endAngle) || (r < 0)) return;
+    if (ir > r) ir = r;
+    if (ir < 0) ir = 0;
+
+    aaShape s;
+    s.type = aaArc;
+    s.x = x; s.y = y;
+    s.r0 = r + 0.5f; s.r1 = ir - 0.5f;
+
+    uint32_t sweep = (endAngle + 360 - startAngle) % 360;
+    s.full = (sweep == 0);
+    s.wide = (sweep > 180);
+    s.roundEnds = roundEnds;
+    s.h = (s.r0 - s.r1) / 2.0f;
+
+    // Unit vectors from the centre towards each end
+    float a = startAngle * 0.0174532925f;
+    s.ux = -sinf(a); s.uy = cosf(a);
+    a = endAngle * 0.0174532925f;
+    s.vx = -sinf(a); s.vy = cosf(a);
+
+    s.x0 = x - r - 1; s.x1 = x + r + 1;
+    s.y0 = y - r - 1; s.y1 = y + r + 1;
+
+    drawSmoothShape(s, fg_color, bg_color);
+}
+
+
+/***************************************************************************************
+** Function name:           drawSmoothRoundRect
+** Description:             Draw an anti-aliased rounded rectangle outline
+***************************************************************************************/
+void TFT_eSPI::drawSmoothRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t radius, uint32_t color, uint32_t bg_color) {
+    if ((w < 1) || (h < 1)) return;
+
+    aaShape s;
+    s.type = aaBox;
+    s.full = false;
+    s.h = 1.0f;
+
+    int32_t r = (w < h) ? w / 2 : h / 2; // Corner radius is limited to fit
+    if (radius < r) r = radius;
+    if (r < 0) r = 0;
+
+    s.x = x + (w - 1) / 2.0f; s.y = y + (h - 1) / 2.0f;
+    s.r0 = r + 0.5f;
+    if (s.r0 > w / 2.0f) s.r0 = w / 2.0f;
+    if (s.r0 > h / 2.0f) s.r0 = h / 2.0f;
+    s.ux = w / 2.0f - s.r0; s.uy = h / 2.0f - s.r0;
+
+    s.x0 = x; s.x1 = x + w - 1;
+    s.y0 = y; s.y1 = y + h - 1;
+
+    drawSmoothShape(s, color, bg_color);
+}
+
+
+/***************************************************************************************
+** Function name:           fillSmoothRoundRect
+** Description:             Draw an anti-aliased filled rounded rectangle
+***************************************************************************************/
+void TFT_eSPI::fillSmoothRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t radius, uint32_t color, uint32_t bg_color) {
+    if ((w < 1) || (h < 1)) return;
+
+    aaShape s;
+    s.type = aaBox;
+    s.full = true;
+
+    int32_t r = (w < h) ? w / 2 : h / 2; // Corner radius is limited to fit
+    if (radius < r) r = radius;
+    if (r < 0) r = 0;
+
+    s.x = x + (w - 1) / 2.0f; s.y = y + (h - 1) / 2.0f;
+    s.r0 = r + 0.5f;
+    if (s.r0 > w / 2.0f) s.r0 = w / 2.0f;
+    if (s.r0 > h / 2.0f) s.r0 = h / 2.0f;
+    s.ux = w / 2.0f - s.r0; s.uy = h / 2.0f - s.r0;
+
+    s.x0 = x; s.x1 = x + w - 1;
+    s.y0 = y; s.y1 = y + h - 1;
+
+    drawSmoothShape(s, color, bg_color);
+}
+
+
+// Signed distance from a point to an ellipse with semi-axes a and b centred on the origin.
+// The nearest point on the ellipse is refined three times from the 45 degree point, each
+// time through the centre of curvature of the current point, which leaves an error under
+// 0.01 pixel for any ellipse shape
+static float ellipseDistance(float a, float b, float px, float py) {
+    px = fabsf(px);
+    py = fabsf(py);
+
+    float tx = 0.70710678f, ty = 0.70710678f;
+    for (uint8_t i = 0; i < 3; i++) {
+        float ex = (a * a - b * b) * tx * tx * tx / a; // Centre of curvature
+        float ey = (b * b - a * a) * ty * ty * ty / b;
+        float rx = a * tx - ex, ry = b * ty - ey;
+        float qx = px - ex,     qy = py - ey;
+        float q = sqrtf(qx * qx + qy * qy);
+        if (q > 0) {
+            float r = sqrtf(rx * rx + ry * ry) / q;
+            tx = (qx * r + ex) / a;
+            ty = (qy * r + ey) / b;
+            if (tx < 0) tx = 0; else if (tx > 1) tx = 1;
+            if (ty < 0) ty = 0; else if (ty > 1) ty = 1;
+        }
+        float t = sqrtf(tx * tx + ty * ty);
+        tx /= t;
+        ty /= t;
+    }
+
+    float dx = px - a * tx, dy = py - b * ty;
+    float d = sqrtf(dx * dx + dy * dy);
+    return (px * px * b * b + py * py * a * a < a * a * b * b) ? -d : d;
+}
+
+
+/***************************************************************************************
+** Function name:           aaDistance
+** Description:             Signed distance from a pixel centre to a shape edge
+***************************************************************************************/
+// Negative inside. Shapes built from several edges return a distance that may be short,
+// but is never too long, so it is safe to step along a row by that many pixels
+float TFT_eSPI::aaDistance(const aaShape &s, float px, float py) {
+    px -= s.x;
+    py -= s.y;
+
+    if (s.type == aaWedge) {
+        if (s.h == 0) return sqrtf(px * px + py * py) - s.r0;
+
+        // Position across and along the line, as a fraction of its length
+        float qx = fabsf(px * s.uy - py * s.ux) / s.h;
+        float qy = (px * s.ux + py * s.uy) / s.h;
+        float k  = s.vx * qy - s.vy * qx;
+        if (k < 0) return sqrtf(s.h * (qx * qx + qy * qy)) - s.r0;
+        if (k > s.vx) return sqrtf(s.h * (qx * qx + qy * qy + 1.0f - 2.0f * qy)) - s.r1;
+        return s.vx * qx + s.vy * qy - s.r0;
+    }
+
+    if (s.type == aaArc) {
+        float r = sqrtf(px * px + py * py);
+        float d = (r - s.r0 > s.r1 - r) ? r - s.r0 : s.r1 - r;
+        if (s.full) return d;
+
+        // Distance outside the start and end edges, clockwise from start is inside
+        float ds = px * s.uy - py * s.ux;
+        float de = py * s.vx - px * s.vy;
+        float dw = s.wide ? ((ds < de) ? ds : de) : ((ds > de) ? ds : de);
+        if (dw > d) d = dw;
+
+        if (s.roundEnds) {
+            float rm = (s.r0 + s.r1) / 2.0f;
+            float dx = px - s.ux * rm, dy = py - s.uy * rm;
+            float dc = sqrtf(dx * dx + dy * dy) - s.h;
+            if (dc < d) d = dc;
+            dx = px - s.vx * rm; dy = py - s.vy * rm;
+            dc = sqrtf(dx * dx + dy * dy) - s.h;
+            if (dc < d) d = dc;
+        }
+        return d;
+    }
+
+    if (s.type == aaEllipse) {
+        float d = ellipseDistance(s.r0, s.r1, px, py);
+        if (!s.full) {
+            float di = -ellipseDistance(s.ux, s.uy, px, py);
+            if (di > d) d = di;
+        }
+        // Shortened away from the edge so the small error cannot make a step too long
+        if (d > 1.0f) d -= 0.01f;
+        else if (d < -1.0f) d += 0.01f;
+        return d;
+    }
+
+    // aaBox
+    float qx = fabsf(px) - s.ux;
+    float qy = fabsf(py) - s.uy;
+    float d  = (qx > qy) ? qx : qy;
+    if (d > 0) {
+        if (qx < 0) qx = 0;
+        if (qy < 0) qy = 0;
+        d = sqrtf(qx * qx + qy * qy);
+    }
+    d -= s.r0;
+    if (!s.full && (-(d + s.h) > d)) d = -(d + s.h);
+    return d;
+}
+
+
+/***************************************************************************************
+** Function name:           drawSmoothShape
+** Description:             Draw an anti-aliased shape one row at a time
+***************************************************************************************/
+// The edge distance tells how many pixels along a row are certainly outside, or certainly
+// inside, so only pixels side an edge are tested one by one. Covered segments are drawn
+// as lines, or as one rectangle while rows have the same single segment. Partly covered
+// pixels are blended as a run
+void TFT_eSPI::drawSmoothShape(const aaShape &s, uint32_t fg, uint32_t bg) {
+    if (_vpOoB) return;
+
+    int32_t x0 = s.x0, y0 = s.y0, x1 = s.x1, y1 = s.y1;
+    if (x0 < _vpX - _xDatum) x0 = _vpX - _xDatum;
+    if (y0 < _vpY - _yDatum) y0 = _vpY - _yDatum;
+    if (x1 >= _vpW - _xDatum) x1 = _vpW - _xDatum - 1;
+    if (y1 >= _vpH - _yDatum) y1 = _vpH - _yDatum - 1;
+    if ((x0 > x1) || (y0 > y1)) return;
+
+    //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
+    inTransaction = true;
+
+    alphaRun run;
+    run.n = 0;
+    run.vertical = false;
+    spanRun  solid = {0, 0, 0, 0};
+    int32_t  seg[4][2];
+
+    for (int32_t yy = y0; yy <= y1; yy++) {
+        uint16_t segs = 0;
+        int32_t  xx = x0;
+
+        while (xx <= x1) {
+            float d = aaDistance(s, xx, yy);
+
+            if (d >= 0.5f) { // Outside, skip pixels that must also be outside
+                xx += (int32_t)(d - 0.5f) + 1;
+                continue;
+            }
+
+            if (d <= -0.5f) { // Inside, the next pixels are also inside
+                int32_t xe = xx + (int32_t)(-d - 0.5f);
+                if (xe > x1) xe = x1;
+                if (segs && (seg[segs - 1][1] == xx - 1)) seg[segs - 1][1] = xe;
+                else if (segs < 4) { seg[segs][0] = xx; seg[segs++][1] = xe; }
+                else drawFastHLine(xx, yy, xe - xx + 1, fg);
+                xx = xe + 1;
+                continue;
+            }
+
+            addAlpha(run, xx, yy, (0.5f - d) * 255.0f + 0.5f, fg, bg);
+            xx++;
+        }
+
+        if (segs == 1) pushSpan(solid, seg[0][0], seg[0][1], yy, fg);
+        else {
+            pushSpan(solid, 0, -1, yy, fg); // Flush
+            for (uint16_t i = 0; i < segs; i++) drawFastHLine(seg[i][0], yy, seg[i][1] - seg[i][0] + 1, fg);
+        }
+    }
+    pushSpan(solid, 0, -1, y1 + 1, fg); // Flush
+    pushAlphaRun(run, fg, bg);
+
+    inTransaction = lockTransaction;
+    end_tft_write();              // Does nothing if Sprite class uses this function
+}
+
+
+/***************************************************************************************
+** Function name:           addAlpha
+** Description:             Add a partly covered pixel to a run
+***************************************************************************************/
+// The run is drawn first if the pixel does not follow on from it. Zero alpha pixels are
+// not drawn, so they end the run
+void TFT_eSPI::addAlpha(alphaRun &run, int32_t x, int32_t y, uint8_t alpha, uint32_t fg, uint32_t bg) {
+    if (run.n) {
+        bool next = run.vertical ? ((x == run.x) && (y == run.y + run.n)) : ((y == run.y) && (x == run.x + run.n));
+        if (!alpha || !next || (run.n == sizeof(run.alpha))) pushAlphaRun(run, fg, bg);
+    }
+    if (!alpha) return;
+
+    if (!run.n) { run.x = x; run.y = y; }
+    run.alpha[run.n++] = alpha;
+}
+
+
+/***************************************************************************************
+** Function name:           blendAlphaRun
+** Description:             Blend a run of pixels into a buffer of colours
+***************************************************************************************/
+void TFT_eSPI::blendAlphaRun(const alphaRun &run, uint32_t fg, uint32_t bg, uint16_t *buf) {
+    for (uint16_t i = 0; i < run.n; i++) {
+        uint8_t alpha = run.alpha[i];
+        if (alpha == 255) { buf[i] = fg; continue; }
+
+        uint16_t bgc = bg;
+        if (bg == 0x00FFFFFF) bgc = run.vertical ? readPixel(run.x, run.y + i) : readPixel(run.x + i, run.y);
+        buf[i] = alphaBlend(alpha, fg, bgc);
+    }
+}
+
+
+/***************************************************************************************
+** Function name:           pushAlphaRun
+** Description:             Draw a run of blended pixels and empty it
+***************************************************************************************/
+void TFT_eSPI::pushAlphaRun(alphaRun &run, uint32_t fg, uint32_t bg) {
+    if (!run.n) return;
+
+    uint16_t buf[run.n];
+    blendAlphaRun(run, fg, bg, buf);
+
+    bool swap = _swapBytes;
+    _swapBytes = true; // buf holds native colour values
+    if (run.vertical) pushImage(run.x, run.y, 1, run.n, buf);
+    else pushImage(run.x, run.y, run.n, 1, buf);
+    _swapBytes = swap; // Restore old value
+
+    run.n = 0;
+}
+
+
+/***************************************************************************************
+** Function name:           drawBitmap
+** Description:             Draw an image stored in an array on the TFT
+***************************************************************************************/
+void TFT_eSPI::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color) {
+    //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
+    inTransaction = true;
+
+    int32_t i, j, byteWidth = (w + 7) / 8;
+
+    for (j = 0; j < h; j++) {
+        for (i = 0; i < w; i++) {
+            if (pgm_read_byte(bitmap + j * byteWidth + i / 8) & (128 >> (i & 7))) {
+                drawPixel(x + i, y + j, color);
+            }
+        }
+    }
+
+    inTransaction = lockTransaction;
+    end_tft_write();              // Does nothing if Sprite class uses this function
+}
+
+
+/***************************************************************************************
+** Function name:           drawBitmap
+** Description:             Draw an image stored in an array on the TFT
+***************************************************************************************/
+void TFT_eSPI::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t fgcolor, uint16_t bgcolor) {
+    //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
+    inTransaction = true;
+
+    int32_t i, j, byteWidth = (w + 7) / 8;
+
+    for (j = 0; j < h; j++) {
+        for (i = 0; i < w; i++) {
+            if (pgm_read_byte(bitmap + j * byteWidth + i / 8) & (128 >> (i & 7)))
+                drawPixel(x + i, y + j, fgcolor);
+            else drawPixel(x + i, y + j, bgcolor);
+        }
+    }
+
+    inTransaction = lockTransaction;
+    end_tft_write();              // Does nothing if Sprite class uses this function
+}
+
+/***************************************************************************************
+** Function name:           drawXBitmap
+** Description:             Draw an image stored in an XBM array onto the TFT
+***************************************************************************************/
+void TFT_eSPI::drawXBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color) {
+    //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
+    inTransaction = true;
+
+    int32_t i, j, byteWidth = (w + 7) / 8;
+
+    for (j = 0; j < h; j++) {
+        for (i = 0; i < w; i++) {
+            if (pgm_read_byte(bitmap + j * byteWidth + i / 8) & (1 << (i & 7))) {
+                drawPixel(x + i, y + j, color);
+            }
+        }
+    }
+
+    inTransaction = lockTransaction;
+    end_tft_write();              // Does nothing if Sprite class uses this function
+}
+
+
+/***************************************************************************************
+** Function name:           drawXBitmap
+** Description:             Draw an XBM image with foreground and background colors
+***************************************************************************************/
+void TFT_eSPI::drawXBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bgcolor) {
+    //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
+    inTransaction = true;
+
+    int32_t i, j, byteWidth = (w + 7) / 8;
+
+    for (j = 0; j < h; j++) {
+        for (i = 0; i < w; i++) {
+            if (pgm_read_byte(bitmap + j * byteWidth + i / 8) & (1 << (i & 7)))
+                drawPixel(x + i, y + j, color);
+            else drawPixel(x + i, y + j, bgcolor);
+        }
+    }
+
+    inTransaction = lockTransaction;
+    end_tft_write();              // Does nothing if Sprite class uses this function
+}
+
+
+/***************************************************************************************
+** Function name:           setCursor
+** Description:             Set the text cursor x,y position
+***************************************************************************************/
+void TFT_eSPI::setCursor(int16_t x, int16_t y) {
+    cursor_x = x;
+    cursor_y = y;
+}
+
+
+/***************************************************************************************
+** Function name:           setCursor
+** Description:             Set the text cursor x,y position and font
+***************************************************************************************/
+void TFT_eSPI::setCursor(int16_t x, int16_t y, uint8_t font) {
+    textfont = font;
+    cursor_x = x;
+    cursor_y = y;
+}
+
+
+/***************************************************************************************
+** Function name:           getCursorX
+** Description:             Get the text cursor x position
+***************************************************************************************/
+int16_t TFT_eSPI::getCursorX(void) {
+    return cursor_x;
+}
+
+/***************************************************************************************
+** Function name:           getCursorY
+** Description:             Get the text cursor y position
+***************************************************************************************/
+int16_t TFT_eSPI::getCursorY(void) {
+    return cursor_y;
+}
+
+
+/***************************************************************************************
+** Function name:           setTextSize
+** Description:             Set the text size multiplier
+***************************************************************************************/
+void TFT_eSPI::setTextSize(uint8_t s) {
+    if (s > 7) s = 7; // Limit the maximum size multiplier so byte variables can be used for rendering
+    textsize = (s > 0) ? s : 1; // Don't allow font size 0
+}
+
+
+/***************************************************************************************
+** Function name:           setTextColor
+** Description:             Set the font foreground colour (background is transparent)
+***************************************************************************************/
+void TFT_eSPI::setTextColor(uint16_t c) {
+    // For 'transparent' background, we'll set the bg
+    // to the same as fg instead of using a flag
+    textcolor = textbgcolor = c;
+}
+
+
+/***************************************************************************************
+** Function name:           setTextColor
+** Description:             Set the font foreground and background colour
+***************************************************************************************/
+void TFT_eSPI::setTextColor(uint16_t c, uint16_t b) {
+    textcolor = c;
+    textbgcolor = b;
+}
+
+
+/***************************************************************************************
+** Function name:           setPivot
+** Description:             Set the pivot point on the TFT
+*************************************************************************************x*/
+void TFT_eSPI::setPivot(int16_t x, int16_t y) {
+    _xPivot = x;
+    _yPivot = y;
+}
+
+
+/***************************************************************************************
+** Function name:           getPivotX
+** Description:             Get the x pivot position
+***************************************************************************************/
+int16_t TFT_eSPI::getPivotX(void) {
+    return _xPivot;
+}
+
+
+/***************************************************************************************
+** Function name:           getPivotY
+** Description:             Get the y pivot position
+***************************************************************************************/
+int16_t TFT_eSPI::getPivotY(void) {
+    return _yPivot;
+}
+
+
+/***************************************************************************************
+** Function name:           setBitmapColor
+** Description:             Set the foreground foreground and background colour
+***************************************************************************************/
+void TFT_eSPI::setBitmapColor(uint16_t c, uint16_t b) {
+    if (c == b) b = ~c;
+    bitmap_fg = c;
+    bitmap_bg = b;
+}
+
+
+/***************************************************************************************
+** Function name:           setTextWrap
+** Description:             Define if text should wrap at end of line
+***************************************************************************************/
+void TFT_eSPI::setTextWrap(bool wrapX, bool wrapY) {
+    textwrapX = wrapX;
+    textwrapY = wrapY;
+}
+
+
+/***************************************************************************************
+** Function name:           setTextDatum
+** Description:             Set the text position reference datum
+***************************************************************************************/
+void TFT_eSPI::setTextDatum(uint8_t d) {
+    textdatum = d;
+}
+
+
+/***************************************************************************************
+** Function name:           setTextPadding
+** Description:             Define padding width (aids erasing old text and numbers)
 ***************************************************************************************/
 void TFT_eSPI::setTextPadding(uint16_t x_width) {
     padX = x_width;
@@ -2239,66 +3016,201 @@ int16_t TFT_eSPI::textWidth(const char *string) {
 }
 
 int16_t TFT_eSPI::textWidth(const char *string, uint8_t font) {
+    int16_t ascent, descent;
+    return textExtent(string, font, &ascent, &descent);
+}
+
+
+/***************************************************************************************
+** Function name:           textExtent
+** Description:             Return the width of a string and its extent about the baseline
+***************************************************************************************/
+int16_t TFT_eSPI::textExtent(const char *string, uint8_t font, int16_t *ascent, int16_t *descent) {
     int32_t str_width = 0;
+    int16_t asc = 0, desc = 0;
     uint16_t uniCode = 0;
 
+    textWidthEntry *entry = nullptr;
+    uint32_t hash = 2166136261UL; // FNV-1a offset basis
+    uint32_t check = 0;           // Jenkins one-at-a-time hash, independent of FNV-1a
+    char prefix[sizeof(entry->prefix)] = { 0 };
+    uint16_t len = 0;
+    uint8_t size = textsize | (isDigits ? 0x80 : 0);
+    const void *face = nullptr;
+
+#ifdef LOAD_GFXFF
+    face = gfxFont;
+#endif
+#ifdef SMOOTH_FONT
+    if (fontLoaded) face = gArena;
+#endif
+
+    if (widthCache) {
+        for (const char *c = string; *c; c++, len++) {
+            hash = (hash ^ (uint8_t) *c) * 16777619UL;
+            check += (uint8_t) *c;
+            check += check << 10;
+            check ^= check >> 6;
+            if (len < sizeof(prefix)) prefix[len] = *c;
+        }
+        check += check << 3;
+        check ^= check >> 11;
+        check += check << 15;
+        // Mix in the font so the same string in different fonts maps to different entries
+        hash = (hash ^ font) * 16777619UL;
+        hash = (hash ^ size) * 16777619UL;
+        hash = (hash ^ (uint32_t) (uintptr_t) face) * 16777619UL;
+
+        entry = &widthCache[(hash ^ (hash >> 16)) % widthCacheSize]; // Fold, the low FNV bits miss pointer changes
+        if (entry->size == size && entry->hash == hash && entry->len == len &&
+            entry->font == font && entry->face == face && entry->check == check &&
+            !memcmp(entry->prefix, prefix, sizeof(prefix))) {
+            widthCacheHits++;
+            isDigits = false;
+            *ascent = entry->ascent;
+            *descent = entry->descent;
+            return entry->width;
+        }
+        widthCacheMisses++;
+    }
+
 #ifdef SMOOTH_FONT
     if (fontLoaded) {
+        uint16_t last = 0; // Previous glyph for kerning
         while (*string) {
             uniCode = decodeUTF8(*string++);
             if (uniCode) {
-                if (uniCode == 0x20) str_width += gFont.spaceWidth;
+                if (uniCode == 0x20) { str_width += gFont.spaceWidth; last = 0; }
                 else {
                     uint16_t gNum = 0;
                     bool found = getUnicodeIndex(uniCode, &gNum);
                     if (found) {
+                        if (last) str_width += getKerning(last, uniCode);
+                        last = uniCode;
                         if (str_width == 0 && gdX[gNum] < 0) str_width -= gdX[gNum];
                         if (*string || isDigits) str_width += gxAdvance[gNum];
                         else str_width += (gdX[gNum] + gWidth[gNum]);
-                    } else str_width += gFont.spaceWidth + 1;
+                        if (gdY[gNum] > asc) asc = gdY[gNum];
+                        if (gHeight[gNum] - gdY[gNum] > desc) desc = gHeight[gNum] - gdY[gNum];
+                    } else {
+                        str_width += gFont.spaceWidth + 1;
+                        last = 0;
+                        if (gFont.ascent > asc) asc = gFont.ascent;
+                    }
                 }
             }
         }
-        isDigits = false;
-        return str_width;
-    }
+    } else
 #endif
+    {
+        if (font > 1 && font < 9) {
+            char *widthtable = (char *) pgm_read_dword(&(fontdata[font].widthtbl)) - 32; //subtract the 32 outside the loop
 
-    if (font > 1 && font < 9) {
-        char *widthtable = (char *) pgm_read_dword(&(fontdata[font].widthtbl)) - 32; //subtract the 32 outside the loop
+            while (*string) {
+                uniCode = *(string++);
+                if (uniCode > 31 && uniCode < 128)
+                    str_width += pgm_read_byte(widthtable + uniCode); // Normally we need to subtract 32 from uniCode
+                else str_width += pgm_read_byte(widthtable + 32); // Set illegal character = space width
+            }
 
-        while (*string) {
-            uniCode = *(string++);
-            if (uniCode > 31 && uniCode < 128)
-                str_width += pgm_read_byte(widthtable + uniCode); // Normally we need to subtract 32 from uniCode
-            else str_width += pgm_read_byte(widthtable + 32); // Set illegal character = space width
-        }
+            // No per glyph heights, use the font baseline
+            asc = pgm_read_byte(&fontdata[font].baseline);
+            desc = pgm_read_byte(&fontdata[font].height) - asc;
 
-    } else {
+        } else {
 
 #ifdef LOAD_GFXFF
-        if (gfxFont) { // New font
-            while (*string) {
-                uniCode = decodeUTF8(*string++);
-                if ((uniCode >= pgm_read_word(&gfxFont->first)) && (uniCode <= pgm_read_word(&gfxFont->last))) {
-                    uniCode -= pgm_read_word(&gfxFont->first);
-                    GFXglyph *glyph = &(((GFXglyph *) pgm_read_dword(&gfxFont->glyph))[uniCode]);
-                    // If this is not the  last character or is a digit then use xAdvance
-                    if (*string || isDigits) str_width += pgm_read_byte(&glyph->xAdvance);
-                        // Else use the offset plus width since this can be bigger than xAdvance
-                    else str_width += ((int8_t) pgm_read_byte(&glyph->xOffset) + pgm_read_byte(&glyph->width));
+            if (gfxFont) { // New font
+                while (*string) {
+                    uniCode = decodeUTF8(*string++);
+                    if ((uniCode >= pgm_read_word(&gfxFont->first)) && (uniCode <= pgm_read_word(&gfxFont->last))) {
+                        uniCode -= pgm_read_word(&gfxFont->first);
+                        GFXglyph *glyph = &(((GFXglyph *) pgm_read_dword(&gfxFont->glyph))[uniCode]);
+                        // If this is not the  last character or is a digit then use xAdvance
+                        if (*string || isDigits) str_width += pgm_read_byte(&glyph->xAdvance);
+                            // Else use the offset plus width since this can be bigger than xAdvance
+                        else str_width += ((int8_t) pgm_read_byte(&glyph->xOffset) + pgm_read_byte(&glyph->width));
+
+                        int8_t yOffset = pgm_read_byte(&glyph->yOffset); // Negative above the baseline
+                        if (-yOffset > asc) asc = -yOffset;
+                        if (yOffset + pgm_read_byte(&glyph->height) > desc) desc = yOffset + pgm_read_byte(&glyph->height);
+                    }
                 }
-            }
-        } else
+            } else
 #endif
-        {
+            {
 #ifdef LOAD_GLCD
-            while (*string++) str_width += 6;
+                while (*string++) str_width += 6;
+                asc = 7; // 5x7 characters with a one pixel descender
+                desc = 1;
 #endif
+            }
         }
+        str_width *= textsize;
+        asc *= textsize;
+        desc *= textsize;
     }
     isDigits = false;
-    return str_width * textsize;
+
+    if (entry) {
+        entry->hash = hash;
+        entry->check = check;
+        memcpy(entry->prefix, prefix, sizeof(prefix));
+        entry->face = face;
+        entry->len = len;
+        entry->font = font;
+        entry->size = size;
+        entry->width = str_width;
+        entry->ascent = asc;
+        entry->descent = desc;
+    }
+
+    *ascent = asc;
+    *descent = desc;
+    return str_width;
+}
+
+
+/***************************************************************************************
+** Function name:           setTextWidthCache
+** Description:             Allocate (or free if 0) the text width cache
+***************************************************************************************/
+bool TFT_eSPI::setTextWidthCache(uint16_t entries) {
+    if (widthCache) free(widthCache);
+    widthCache = nullptr;
+    widthCacheSize = 0;
+
+    if (entries == 0) return true;
+
+    widthCache = (textWidthEntry *) malloc(entries * sizeof(textWidthEntry));
+    if (!widthCache) return false;
+
+    widthCacheSize = entries;
+    for (uint16_t i = 0; i < widthCacheSize; i++) widthCache[i].size = 0;
+    return true;
+}
+
+
+/***************************************************************************************
+** Function name:           getTextWidthCacheStats
+** Description:             Get the text width cache hit and miss counts, optionally reset them
+***************************************************************************************/
+void TFT_eSPI::getTextWidthCacheStats(uint32_t *hits, uint32_t *misses, bool reset) {
+    if (hits) *hits = widthCacheHits;
+    if (misses) *misses = widthCacheMisses;
+    if (reset) { widthCacheHits = 0; widthCacheMisses = 0; }
+}
+
+
+/***************************************************************************************
+** Function name:           flushTextWidthCache
+** Description:             Empty the text width cache entries for a font
+***************************************************************************************/
+// Called when a smooth font is unloaded as a new font may reuse the memory address
+void TFT_eSPI::flushTextWidthCache(const void *face) {
+    for (uint16_t i = 0; i < widthCacheSize; i++) {
+        if (widthCache[i].face == face) widthCache[i].size = 0;
+    }
 }
 
 
@@ -2336,6 +3248,41 @@ int16_t TFT_eSPI::fontHeight(void) {
     return fontHeight(textfont);
 }
 
+#ifdef LOAD_GLCD
+/***************************************************************************************
+** Function name:           glcdLookup
+** Description:             Fill the nibble to 4 pixel table used to expand GLCD font rows
+***************************************************************************************/
+static void glcdLookup(uint16_t lut[16][4], uint16_t fg, uint16_t bg) {
+    for (uint8_t n = 0; n < 16; n++) {
+        for (uint8_t b = 0; b < 4; b++) lut[n][b] = (n & (0x08 >> b)) ? fg : bg;
+    }
+}
+
+
+/***************************************************************************************
+** Function name:           glcdExpandRow
+** Description:             Expand a GLCD font row byte into 6 * size pixels
+***************************************************************************************/
+static uint16_t *glcdExpandRow(uint16_t *p, uint8_t row, const uint16_t lut[16][4], uint8_t size) {
+    const uint16_t *hi = lut[row >> 4];   // Columns 0-3
+    const uint16_t *lo = lut[row & 0x0F]; // Columns 4-5, 5 is the gap between characters
+
+    if (size == 1) {
+        p[0] = hi[0]; p[1] = hi[1]; p[2] = hi[2]; p[3] = hi[3];
+        p[4] = lo[0]; p[5] = lo[1];
+        return p + 6;
+    }
+
+    for (uint8_t i = 0; i < 6; i++) {
+        uint16_t color = (i < 4) ? hi[i] : lo[i - 4];
+        for (uint8_t s = 0; s < size; s++) *p++ = color;
+    }
+    return p;
+}
+#endif
+
+
 /***************************************************************************************
 ** Function name:           drawChar
 ** Description:             draw a single character in the GLCD or GFXFF font
@@ -2360,26 +3307,26 @@ void TFT_eSPI::drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32
             ((yd + 8 * size - 1) < _vpY))    // Clip top
             return;
 
+        if (c >= GLCD_CHARS) return; // Not in the font
+
         bool fillbg = (bg != color);
-        bool clip = xd < _vpX || xd + 6 * textsize >= _vpW || yd < _vpY || yd + 8 * textsize >= _vpH;
+        bool clip = xd < _vpX || xd + 6 * size > _vpW || yd < _vpY || yd + 8 * size > _vpH;
+        const uint8_t *rows = glcdRowData::rows + c * 8; // Row ordered character, see glcdfont_rows.h
 
-        if ((size == 1) && fillbg && !clip) {
-            uint8_t column[6];
-            uint8_t mask = 0x1;
-            begin_tft_write();
+        if (fillbg && !clip && !dlRecording) {
+            // Whole character cell in one window, rows expanded through a nibble lookup table
+            uint16_t lut[16][4];
+            uint16_t line[6 * size];
 
-            setWindow(xd, yd, xd + 5, yd + 8);
+            glcdLookup(lut, color, bg);
 
-            for (int8_t i = 0; i < 5; i++) column[i] = pgm_read_byte(font + (c * 5) + i);
-            column[5] = 0;
+            begin_tft_write();
+
+            setWindow(xd, yd, xd + 6 * size - 1, yd + 8 * size - 1);
 
             for (int8_t j = 0; j < 8; j++) {
-                for (int8_t k = 0; k < 5; k++) {
-                    if (column[k] & mask) { tft_Write_16(color); }
-                    else { tft_Write_16(bg); }
-                }
-                mask <<= 1;
-                tft_Write_16(bg);
+                glcdExpandRow(line, pgm_read_byte(rows + j), lut, size);
+                for (uint8_t s = 0; s < size; s++) pushSwapBytePixels(line, 6 * size);
             }
 
             end_tft_write();
@@ -2387,24 +3334,21 @@ void TFT_eSPI::drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32
             //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
             inTransaction = true;
 
-            for (int8_t i = 0; i < 6; i++) {
-                uint8_t line;
-                if (i == 5)
-                    line = 0x0;
-                else
-                    line = pgm_read_byte(font + (c * 5) + i);
-
-                if (size == 1 && !fillbg) { // default size
-                    for (int8_t j = 0; j < 8; j++) {
-                        if (line & 0x1) drawPixel(x + i, y + j, color);
-                        line >>= 1;
-                    }
-                } else {  // big size or clipped
-                    for (int8_t j = 0; j < 8; j++) {
-                        if (line & 0x1) fillRect(x + (i * size), y + (j * size), size, size, color);
-                        else if (fillbg) fillRect(x + i * size, y + j * size, size, size, bg);
-                        line >>= 1;
+            // Draw each run of foreground (and background if filled) pixels in a row as one line
+            for (int8_t j = 0; j < 8; j++) {
+                uint8_t line = pgm_read_byte(rows + j);
+                int8_t i = 0;
+
+                while (i < 6) {
+                    bool set = line & (0x80 >> i);
+                    int8_t n = 1;
+                    while ((i + n < 6) && (((line & (0x80 >> (i + n))) != 0) == set)) n++;
+
+                    if (set || fillbg) {
+                        if (size == 1) drawFastHLine(x + i, y + j, n, set ? color : bg);
+                        else fillRect(x + i * size, y + j * size, n * size, size, set ? color : bg);
                     }
+                    i += n;
                 }
             }
             inTransaction = lockTransaction;
@@ -2497,6 +3441,215 @@ void TFT_eSPI::setAddrWindow(int32_t x0, int32_t y0, int32_t w, int32_t h) {
 }
 
 
+/***************************************************************************************
+** Function name:           getWindowBytesSaved
+** Description:             Return count of window command bytes not sent as unchanged
+***************************************************************************************/
+uint32_t TFT_eSPI::getWindowBytesSaved(bool reset) {
+    uint32_t saved = winBytesSaved;
+    if (reset) winBytesSaved = 0;
+    return saved;
+}
+
+
+/***************************************************************************************
+** Function name:           setDisplayList
+** Description:             Allocate (or free if 0) the display list and its band buffer
+***************************************************************************************/
+bool TFT_eSPI::setDisplayList(uint16_t items, uint16_t bandRows) {
+    if (dlRecording) drawDisplayList();
+    dlRecording = false;
+
+    if (dlList) free(dlList);
+    if (dlBand) free(dlBand);
+    if (dlMask) free(dlMask);
+    dlList = nullptr;
+    dlBand = nullptr;
+    dlMask = nullptr;
+    dlSize = 0;
+    dlCount = 0;
+
+    if ((items == 0) || (bandRows == 0)) return true;
+
+    // The band is as wide as the longest side so it fits every rotation
+    uint16_t stride = (_init_width > _init_height) ? _init_width : _init_height;
+    stride = (stride + 7) & ~7;
+
+    dlList = (dlItem *) malloc(items * sizeof(dlItem));
+    dlBand = (uint16_t *) malloc(stride * bandRows * 2);
+    dlMask = (uint8_t *) malloc((stride >> 3) * bandRows);
+
+    if (!dlList || !dlBand || !dlMask) {
+        setDisplayList(0);
+        return false;
+    }
+
+    dlSize = items;
+    dlStride = stride;
+    dlBandRows = bandRows;
+    return true;
+}
+
+
+/***************************************************************************************
+** Function name:           startRecording
+** Description:             Record drawing in the display list, false if there is no list
+***************************************************************************************/
+bool TFT_eSPI::startRecording(void) {
+    if (!dlList) return false;
+    dlRecording = true;
+    return true;
+}
+
+
+/***************************************************************************************
+** Function name:           endRecording
+** Description:             Draw the display list and stop recording
+***************************************************************************************/
+void TFT_eSPI::endRecording(void) {
+    if (dlRecording) drawDisplayList();
+    dlRecording = false;
+}
+
+
+/***************************************************************************************
+** Function name:           getDisplayListStats
+** Description:             Get the pixels drawn and sent counts, optionally reset them
+***************************************************************************************/
+// drawn / sent is the overdraw avoided by drawing the list in bands
+void TFT_eSPI::getDisplayListStats(uint32_t *drawn, uint32_t *sent, bool reset) {
+    if (drawn) *drawn = dlPixelsDrawn;
+    if (sent) *sent = dlPixelsSent;
+    if (reset) { dlPixelsDrawn = 0; dlPixelsSent = 0; }
+}
+
+
+/***************************************************************************************
+** Function name:           recordRect
+** Description:             Add a viewport clipped rectangle to the display list
+***************************************************************************************/
+void TFT_eSPI::recordRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+    if (dlCount == dlSize) drawDisplayList(); // Full, draw what is there and carry on
+
+    dlItem *item = &dlList[dlCount++];
+    item->x = x;
+    item->y = y;
+    item->w = w;
+    item->h = h;
+    item->color = color;
+
+    dlPixelsDrawn += w * h;
+}
+
+
+// Find the first run of set bits in a band mask row at or after bit x, before bit end.
+// Returns the start of the run and sets last to its last bit, or returns -1 if none
+static int32_t maskRun(const uint8_t *mask, int32_t x, int32_t end, int32_t *last) {
+    while (x < end) {
+        uint8_t m = mask[x >> 3];
+        if (!(x & 7) && !m) { x += 8; continue; }
+        if (m & (0x80 >> (x & 7))) break;
+        x++;
+    }
+    if (x >= end) return -1;
+
+    int32_t start = x;
+    while (x < end) {
+        uint8_t m = mask[x >> 3];
+        if (!(x & 7) && (m == 0xFF)) { x += 8; continue; }
+        if (!(m & (0x80 >> (x & 7)))) break;
+        x++;
+    }
+    *last = ((x < end) ? x : end) - 1;
+    return start;
+}
+
+
+/***************************************************************************************
+** Function name:           drawDisplayList
+** Description:             Draw the display list a band of rows at a time and empty it
+***************************************************************************************/
+// The items covering a band are drawn in recorded order into the band buffer, so later
+// items cover earlier ones there and not on the TFT. Each run of covered pixels is then
+// sent once. Rows with the same single run share one window, each band is one transaction
+void TFT_eSPI::drawDisplayList(void) {
+    if (!dlCount) return;
+
+    bool recording = dlRecording;
+    dlRecording = false; // Now draw on the TFT
+
+    // Rows and columns touched by the list
+    int32_t ys = dlList[0].y, ye = ys, xe = 0;
+    for (uint16_t i = 0; i < dlCount; i++) {
+        dlItem *item = &dlList[i];
+        if (item->y < ys) ys = item->y;
+        if (item->y + item->h - 1 > ye) ye = item->y + item->h - 1;
+        if (item->x + item->w > xe) xe = item->x + item->w;
+    }
+
+    uint16_t maskStride = dlStride >> 3;
+
+    for (int32_t by = ys; by <= ye; by += dlBandRows) {
+        int32_t rows = ye - by + 1;
+        if (rows > dlBandRows) rows = dlBandRows;
+
+        memset(dlMask, 0, maskStride * rows);
+
+        for (uint16_t i = 0; i < dlCount; i++) {
+            dlItem *item = &dlList[i];
+            int32_t y0 = (item->y > by) ? item->y : by;
+            int32_t y1 = (item->y + item->h < by + rows) ? item->y + item->h : by + rows;
+
+            for (int32_t y = y0; y < y1; y++) {
+                uint16_t *pix  = dlBand + (y - by) * dlStride;
+                uint8_t  *mask = dlMask + (y - by) * maskStride;
+                for (int32_t x = item->x; x < item->x + item->w; x++) {
+                    pix[x] = item->color;
+                    mask[x >> 3] |= 0x80 >> (x & 7);
+                }
+            }
+        }
+
+        begin_tft_write();
+
+        int32_t wx0 = 0, wx1 = -1, wy = -1; // Open window columns and the next row it takes
+        for (int32_t r = 0; r < rows; r++) {
+            uint16_t *pix  = dlBand + r * dlStride;
+            uint8_t  *mask = dlMask + r * maskStride;
+            int32_t  last, end;
+            int32_t  start = maskRun(mask, 0, xe, &last);
+            if (start < 0) continue;
+
+            // A row with one run continues the open window if the run is the same
+            if (maskRun(mask, last + 1, xe, &end) < 0) {
+                if ((start != wx0) || (last != wx1) || (wy != by + r)) {
+                    setWindow(start, by + r, last, by + rows - 1);
+                    wx0 = start;
+                    wx1 = last;
+                }
+                wy = by + r + 1;
+                pushSwapBytePixels(pix + start, last - start + 1);
+                dlPixelsSent += last - start + 1;
+                continue;
+            }
+
+            wy = -1;
+            while (start >= 0) {
+                setWindow(start, by + r, last, by + r);
+                pushSwapBytePixels(pix + start, last - start + 1);
+                dlPixelsSent += last - start + 1;
+                start = maskRun(mask, last + 1, xe, &last);
+            }
+        }
+
+        end_tft_write();
+    }
+
+    dlCount = 0;
+    dlRecording = recording;
+}
+
+
 /***************************************************************************************
 ** Function name:           setWindow
 ** Description:             define an area to receive a stream of pixels
@@ -2504,8 +3657,15 @@ void TFT_eSPI::setAddrWindow(int32_t x0, int32_t y0, int32_t w, int32_t h) {
 // Chip select stays low, call begin_tft_write first. Use setAddrWindow() from sketches
 void TFT_eSPI::setWindow(int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
     //begin_tft_write(); // Must be called before setWindow
-    addr_row = 0xFFFF;
-    addr_col = 0xFFFF;
+
+    // Pixels not recorded in the display list are drawn after the list so far. The caller
+    // has started a transaction, so it is kept open while the list is drawn
+    if (dlRecording) {
+        bool wasInTransaction = inTransaction;
+        inTransaction = true;
+        drawDisplayList();
+        inTransaction = wasInTransaction;
+    }
 
 #ifdef CGRAM_OFFSET
     x0 += colstart;
@@ -2518,15 +3678,30 @@ void TFT_eSPI::setWindow(int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
 #if defined(ARDUINO_ARCH_RP2040) && !defined(TFT_PARALLEL_8BIT)
 
 #else
+    DMA_BUSY_CHECK; // A DMA block fill may still be in progress
     SPI_BUSY_CHECK;
-    DC_C;
-    tft_Write_8(TFT_CASET);
-    DC_D;
-    tft_Write_32C(x0, x1);
-    DC_C;
-    tft_Write_8(TFT_PASET);
-    DC_D;
-    tft_Write_32C(y0, y1);
+
+    // No need to send the columns or rows if they are unchanged (e.g. text on the same line)
+    if ((addr_col != x0) || (win_xe != x1)) {
+        DC_C;
+        tft_Write_8(TFT_CASET);
+        DC_D;
+        tft_Write_32C(x0, x1);
+        addr_col = x0;
+        win_xe = x1;
+    }
+    else winBytesSaved += 5; // Command and 4 data bytes
+
+    if ((addr_row != y0) || (win_ye != y1)) {
+        DC_C;
+        tft_Write_8(TFT_PASET);
+        DC_D;
+        tft_Write_32C(y0, y1);
+        addr_row = y0;
+        win_ye = y1;
+    }
+    else winBytesSaved += 5;
+
     DC_C;
     tft_Write_8(TFT_RAMWR);
     DC_D;
@@ -2592,6 +3767,8 @@ void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color) {
     // Range checking
     if ((x < _vpX) || (y < _vpY) || (x >= _vpW) || (y >= _vpH)) return;
 
+    if (dlRecording) { recordRect(x, y, 1, 1, color); return; }
+
 #ifdef CGRAM_OFFSET
     x += colstart;
     y += rowstart;
@@ -2599,25 +3776,30 @@ void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color) {
 
     begin_tft_write();
 
+    DMA_BUSY_CHECK;
     SPI_BUSY_CHECK;
 
     // No need to send x if it has not changed (speeds things up)
-    if (addr_col != x) {
+    if ((addr_col != x) || (win_xe != x)) {
         DC_C;
         tft_Write_8(TFT_CASET);
         DC_D;
         tft_Write_32D(x);
         addr_col = x;
+        win_xe = x;
     }
+    else winBytesSaved += 5;
 
     // No need to send y if it has not changed (speeds things up)
-    if (addr_row != y) {
+    if ((addr_row != y) || (win_ye != y)) {
         DC_C;
         tft_Write_8(TFT_PASET);
         DC_D;
         tft_Write_32D(y);
         addr_row = y;
+        win_ye = y;
     }
+    else winBytesSaved += 5;
 
     DC_C;
     tft_Write_8(TFT_RAMWR);
@@ -2723,17 +3905,14 @@ void TFT_eSPI::pushColors(uint16_t *data, uint32_t len, bool swap) {
 ** Function name:           drawLine
 ** Description:             draw a line between 2 arbitrary points
 ***************************************************************************************/
-// Bresenham's algorithm - thx wikipedia - speed enhanced by Bodmer to use
-// an efficient FastH/V Line draw routine for line segments of 2 pixels or more
+// Bresenham's algorithm - thx wikipedia - drawn as runs along the major axis. With dy minor
+// steps over dx major steps, the run on minor step k ends at major step (k * dx + dx / 2) / dy
+// so runs are stepped with a remainder instead of pixel by pixel. Only runs inside the
+// viewport are visited and each one is sent as a single window and pushBlock. The Sprite
+// class has its own drawLine()
 void TFT_eSPI::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) {
     if (_vpOoB) return;
 
-    //begin_tft_write();       // Sprite class can use this function, avoiding begin_tft_write()
-    inTransaction = true;
-
-    //x+= _xDatum;             // Not added here, added by drawPixel & drawFastXLine
-    //y+= _yDatum;
-
     bool steep = abs(y1 - y0) > abs(x1 - x0);
     if (steep) {
         swap_coord(x0, y0);
@@ -2745,45 +3924,74 @@ void TFT_eSPI::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t
         swap_coord(y0, y1);
     }
 
-    int32_t dx = x1 - x0, dy = abs(y1 - y0);;
+    int32_t dx = x1 - x0, dy = abs(y1 - y0);
+    int32_t ystep = (y0 < y1) ? 1 : -1;
+
+    // Viewport limits along (x) and across (y) the line
+    int32_t xlo = steep ? _vpY - _yDatum : _vpX - _xDatum;
+    int32_t xhi = steep ? _vpH - _yDatum - 1 : _vpW - _xDatum - 1;
+    int32_t ylo = steep ? _vpX - _xDatum : _vpY - _yDatum;
+    int32_t yhi = steep ? _vpW - _xDatum - 1 : _vpH - _yDatum - 1;
+    if ((x1 < xlo) || (x0 > xhi)) return;
+
+    // Runs k0 to k1 are inside the viewport across the line
+    int32_t k0 = (ystep > 0) ? ylo - y0 : y0 - yhi;
+    int32_t k1 = (ystep > 0) ? yhi - y0 : y0 - ylo;
+    if (k0 < 0) k0 = 0;
+    if (k1 > dy) k1 = dy;
+
+    // and are not wholly before or after it along the line
+    int32_t h = dx >> 1;
+    if (dx && (xlo > x0)) {
+        int32_t k = ((int64_t)(xlo - x0) * dy - h + dx - 1) / dx; // First run ending at or after xlo
+        if (k > k0) k0 = k;
+    }
+    if (dx && (xhi < x1)) {
+        int32_t k = ((int64_t)(xhi - x0) * dy - h + dx - 1) / dx + 1; // First run starting after xhi
+        if (k - 1 < k1) k1 = k - 1;
+    }
+    if (k0 > k1) return;
+
+    // Start and end of run k0
+    int32_t xs = x0, xe = x1, step = 0, inc = 0, rem = 0;
+    if (dy) {
+        if (k0) xs = x0 + ((int64_t)(k0 - 1) * dx + h) / dy + 1;
+        xe = x0 + ((int64_t)k0 * dx + h) / dy;
+        rem = ((int64_t)k0 * dx + h) % dy;
+        step = dx / dy;
+        inc = dx % dy;
+    }
 
-    int32_t err = dx >> 1, ystep = -1, xs = x0, dlen = 0;
+    if (!dlRecording) begin_tft_write();
 
-    if (y0 < y1) ystep = 1;
+    for (int32_t k = k0; k <= k1; k++) {
+        int32_t a = (xs < xlo) ? xlo : xs;
+        int32_t b = (xe > xhi) ? xhi : xe;
+        if (b > x1) b = x1;
 
-    // Split into steep and not steep for FastH/V separation
-    if (steep) {
-        for (; x0 <= x1; x0++) {
-            dlen++;
-            err -= dy;
-            if (err < 0) {
-                if (dlen == 1) drawPixel(y0, xs, color);
-                else drawFastVLine(y0, xs, dlen, color);
-                dlen = 0;
-                y0 += ystep;
-                xs = x0 + 1;
-                err += dx;
+        if (a <= b) {
+            int32_t y = y0 + k * ystep;
+            if (dlRecording) {
+                if (steep) recordRect(y + _xDatum, a + _yDatum, 1, b - a + 1, color);
+                else recordRect(a + _xDatum, y + _yDatum, b - a + 1, 1, color);
             }
-        }
-        if (dlen) drawFastVLine(y0, xs, dlen, color);
-    } else {
-        for (; x0 <= x1; x0++) {
-            dlen++;
-            err -= dy;
-            if (err < 0) {
-                if (dlen == 1) drawPixel(xs, y0, color);
-                else drawFastHLine(xs, y0, dlen, color);
-                dlen = 0;
-                y0 += ystep;
-                xs = x0 + 1;
-                err += dx;
+            else {
+                if (steep) setWindow(y + _xDatum, a + _yDatum, y + _xDatum, b + _yDatum);
+                else setWindow(a + _xDatum, y + _yDatum, b + _xDatum, y + _yDatum);
+                pushBlock(color, b - a + 1);
             }
         }
-        if (dlen) drawFastHLine(xs, y0, dlen, color);
+
+        xs = xe + 1;
+        xe += step;
+        rem += inc;
+        if (rem >= dy) {
+            rem -= dy;
+            xe++;
+        }
     }
 
-    inTransaction = lockTransaction;
-    end_tft_write();
+    if (!dlRecording) end_tft_write();
 }
 
 
@@ -2809,6 +4017,8 @@ void TFT_eSPI::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) {
 
     if (h < 1) return;
 
+    if (dlRecording) { recordRect(x, y, 1, h, color); return; }
+
     begin_tft_write();
 
     setWindow(x, y, x, y + h - 1);
@@ -2841,6 +4051,8 @@ void TFT_eSPI::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) {
 
     if (w < 1) return;
 
+    if (dlRecording) { recordRect(x, y, w, 1, color); return; }
+
     begin_tft_write();
 
     setWindow(x, y, x + w - 1, y);
@@ -2887,6 +4099,8 @@ void TFT_eSPI::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t col
     //Serial.print(" x=");Serial.print( y);Serial.print(", y=");Serial.print( y);
     //Serial.print(", w=");Serial.print(w);Serial.print(", h=");Serial.println(h);
 
+    if (dlRecording) { recordRect(x, y, w, h, color); return; }
+
     begin_tft_write();
 
     setWindow(x, y, x + w - 1, y + h - 1);
@@ -3722,7 +4936,38 @@ int16_t TFT_eSPI::drawString(const char *string, int32_t poX, int32_t poY, uint8
     uint16_t len = strlen(string);
     uint16_t n = 0;
 
+    // Find the strip covered by the text and the padding fills below
+    int32_t x0 = poX;
+    int32_t x1 = poX + cwidth;
+    if (padX > cwidth) {
+        int32_t padW = padX - cwidth;
+        if (padding == 1) x1 += padW;
+        else if (padding == 2) { x0 -= padW >> 1; x1 += padW >> 1; }
+        else if (padding == 3) {
+            int32_t padXc = poX + cwidth;
+            if (padXc > padX) padXc = padX;
+            if (padXc > cwidth) x0 -= padXc - cwidth;
+        }
+    }
+
+#ifdef LOAD_GLCD
+    bool glcdFont = (font == 1);
+#ifdef LOAD_GFXFF
+    if (gfxFont) glcdFont = false;
+#endif
+#ifdef SMOOTH_FONT
+    if (fontLoaded) glcdFont = false;
+#endif
+    // Text and background in one window if possible
+    if (glcdFont && (textcolor != textbgcolor) && drawStringGlcd(string, poX, poY, x0, x1)) return cwidth;
+#endif
+
 #ifdef SMOOTH_FONT
+    kernCode = 0; // Strings are kerned independently, as in textWidth()
+
+    // Text and background in one window if possible
+    if (fontLoaded && (textcolor != textbgcolor) && drawStringStrip(string, poX, poY, cwidth, x0, x1)) return cwidth;
+
     if (fontLoaded) {
         if (textcolor != textbgcolor) fillRect(poX, poY, cwidth, cheight, textbgcolor);
 /*
@@ -3819,6 +5064,63 @@ int16_t TFT_eSPI::drawString(const char *string, int32_t poX, int32_t poY, uint8
 }
 
 
+#ifdef LOAD_GLCD
+/***************************************************************************************
+** Function name:           drawStringGlcd
+** Description:             Draw a GLCD font string and its padding in a single window
+***************************************************************************************/
+// Returns false if the strip would be clipped or has characters not in the font, the
+// caller then draws the string character by character
+bool TFT_eSPI::drawStringGlcd(const char *string, int32_t poX, int32_t poY, int32_t x0, int32_t x1) {
+    uint16_t len = strlen(string);
+    uint8_t  size = textsize;
+    int32_t  w = x1 - x0;
+    int32_t  xs = x0 + _xDatum;
+    int32_t  ys = poY + _yDatum;
+
+    if (_vpOoB || dlRecording || (len == 0) || (w < 1)) return false; // Recorded character by character
+    if ((xs < _vpX) || (xs + w > _vpW) || (ys < _vpY) || (ys + 8 * size > _vpH)) return false;
+
+    // The strip is within the viewport, so the arrays below are no wider than the screen
+    int32_t tx = poX - x0;       // Text start in the strip, padding to the left
+    int32_t tw = 6 * size * len; // Text width
+    if ((tx < 0) || (tx + tw > w)) return false;
+
+    // One character per byte, as textWidth() assumes when sizing the strip
+    uint8_t codes[len];
+    uint16_t n = 0, count = 0;
+    while (n < len) {
+        uint16_t c = decodeUTF8((uint8_t *) string, &n, len - n);
+        if ((c < 32) || (c >= GLCD_CHARS)) return false;
+        codes[count++] = c;
+    }
+    if (count != len) return false;
+
+    uint16_t lut[16][4];
+    uint16_t line[w];
+    glcdLookup(lut, textcolor, textbgcolor);
+
+    // Padding pixels do not change from row to row
+    for (int32_t i = 0; i < tx; i++) line[i] = textbgcolor;
+    for (int32_t i = tx + tw; i < w; i++) line[i] = textbgcolor;
+
+    begin_tft_write();
+
+    setWindow(xs, ys, xs + w - 1, ys + 8 * size - 1);
+
+    for (int8_t j = 0; j < 8; j++) {
+        uint16_t *p = line + tx;
+        for (uint16_t k = 0; k < len; k++) p = glcdExpandRow(p, pgm_read_byte(glcdRowData::rows + codes[k] * 8 + j), lut, size);
+        for (uint8_t s = 0; s < size; s++) pushSwapBytePixels(line, w);
+    }
+
+    end_tft_write();
+
+    return true;
+}
+#endif
+
+
 /***************************************************************************************
 ** Function name:           drawCentreString (deprecated, use setTextDatum())
 ** Descriptions:            draw string centred on dX
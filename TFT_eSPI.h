@@ -110,6 +110,11 @@
 #define SPI_BUSY_CHECK
 #endif
 
+// Polygons with more corners than this keep their edge tables in the heap, not the stack
+#ifndef POLYGON_STACK_CORNERS
+#define POLYGON_STACK_CORNERS 16
+#endif
+
 /***************************************************************************************
 **                         Section 4: Setup fonts
 ***************************************************************************************/
@@ -119,6 +124,36 @@
 #ifndef LOAD_GLCD
 #define LOAD_GLCD
 #endif
+
+// Smooth font glyph lookup, codes below SMOOTH_ASCII_INDEX use a direct table
+#define SMOOTH_ASCII_INDEX 0x80
+#define SMOOTH_NO_GLYPH    0xFFFF
+
+// vlw version number used by the compact 4 bit run length encoded font format
+#define SMOOTH_RLE_VERSION 0x52
+
+// RAM (PSRAM if available) used to cache glyph bitmaps read from a font file
+#ifndef SMOOTH_GLYPH_CACHE
+#define SMOOTH_GLYPH_CACHE 8192
+#endif
+
+// Number of smooth fonts that can be loaded at the same time, see selectFont()
+#ifndef SMOOTH_FONT_SLOTS
+#define SMOOTH_FONT_SLOTS 2
+#endif
+
+// Maximum pixels in the buffer used to draw a smooth font string with a background
+#ifndef SMOOTH_STRIP_PIXELS
+#define SMOOTH_STRIP_PIXELS 4096
+#endif
+
+// Longest string in bytes drawn as one strip, longer strings are drawn glyph by glyph
+#define SMOOTH_STRIP_CHARS 64
+
+// Read-ahead buffer size in bytes used when loading the metrics from a font file
+#ifndef SMOOTH_READ_BUFFER
+#define SMOOTH_READ_BUFFER 512
+#endif
 #endif
 
 // Only load the fonts defined in User_Setup.h (to save space)
@@ -399,6 +434,12 @@ swap_coord(T &a, T &b) {
 // Callback prototype for smooth font pixel colour read
 typedef uint16_t (*getColorCallback)(uint16_t x, uint16_t y);
 
+// Callback prototype for DMA band streaming, renders w x lines pixels for the area at x,y
+typedef void (*dmaBandCallback)(uint16_t *buffer, int32_t x, int32_t y, int32_t w, int32_t lines);
+
+// Callback prototype for DMA completion, called from the SPI interrupt when the transfer with "fence" ends
+typedef void (*dmaDoneCallback)(uint32_t fence, void *arg);
+
 // Class functions and variables
 class TFT_eSPI : public Print {
     friend class TFT_eSprite; // Sprite class has access to protected members
@@ -435,6 +476,22 @@ public:
     void setAddrWindow(int32_t xs, int32_t ys, int32_t w, int32_t h), // Note: start coordinates + width and height
     setWindow(int32_t xs, int32_t ys, int32_t xe, int32_t ye);   // Note: start + end coordinates
 
+    // Window command bytes skipped because the columns or rows were unchanged, optionally reset the count
+    uint32_t getWindowBytesSaved(bool reset = false);
+
+    // Display list, allocated with room for "items" rectangles and a band of "bandRows" rows,
+    // 0 items (the default) frees it. Returns false if the memory is not available. A list
+    // too small for a whole frame is drawn each time it fills, which saves little
+    bool setDisplayList(uint16_t items, uint16_t bandRows = 16);
+    // Between startRecording() and endRecording() solid fills, lines, pixels and GLCD text are
+    // recorded, then drawn a band of rows at a time so each pixel is sent to the TFT once.
+    // Images, smooth font and anti-aliased drawing, reads and commands draw the list so far
+    // first. DMA transfers are not ordered with the list. TFT only, not for Sprites
+    bool startRecording(void);
+    void endRecording(void);
+    // Pixels drawn by recorded items and pixels sent to the TFT, optionally reset the counts
+    void getDisplayListStats(uint32_t *drawn, uint32_t *sent, bool reset = false);
+
     // Viewport commands, see "Viewport_Demo" sketch
     void setViewport(int32_t x, int32_t y, int32_t w, int32_t h, bool vpDatum = true);
 
@@ -467,7 +524,8 @@ public:
     void pushPixels(const void *data_in, uint32_t len);
 
     // Read the colour of a pixel at x,y and return value in 565 format
-    uint16_t readPixel(int32_t x, int32_t y);
+    // Virtual so anti-aliased drawing can read back a Sprite background
+    virtual uint16_t readPixel(int32_t x, int32_t y);
 
     // Support for half duplex (bi-directional SDA) SPI bus where MOSI must be switched to input
 #ifdef TFT_SDA_READ
@@ -497,6 +555,41 @@ public:
     drawTriangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, uint32_t color),
             fillTriangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, uint32_t color);
 
+    // Fill a polygon of n corners, it may be concave or self crossing (even-odd rule)
+    void fillPolygon(const int32_t *x, const int32_t *y, uint16_t n, uint32_t color);
+
+    // Anti-aliased graphics, edges are blended with bg_color or, if bg_color is omitted,
+    // with the colour read back from the screen (TFT must support reads) or Sprite
+    // Draw a pixel blended with the background, returns the colour drawn
+    uint16_t drawPixel(int32_t x, int32_t y, uint32_t color, uint8_t alpha, uint32_t bg_color = 0x00FFFFFF);
+
+    // Xiaolin Wu line, pixel centres are at integer coordinates
+    void drawSmoothLine(float ax, float ay, float bx, float by, uint32_t fg_color, uint32_t bg_color = 0x00FFFFFF);
+
+    // Lines with round ends, wd wide or tapering from radius ar at a to radius br at b
+    void drawWideLine(float ax, float ay, float bx, float by, float wd, uint32_t fg_color, uint32_t bg_color = 0x00FFFFFF),
+            drawWedgeLine(float ax, float ay, float bx, float by, float ar, float br, uint32_t fg_color, uint32_t bg_color = 0x00FFFFFF);
+
+    // Filled circle of radius r at a sub-pixel position
+    void drawSpot(float ax, float ay, float r, uint32_t fg_color, uint32_t bg_color = 0x00FFFFFF);
+
+    // Circles covering the same pixels as drawCircle() and fillCircle()
+    void drawSmoothCircle(int32_t x, int32_t y, int32_t r, uint32_t fg_color, uint32_t bg_color = 0x00FFFFFF),
+            fillSmoothCircle(int32_t x, int32_t y, int32_t r, uint32_t color, uint32_t bg_color = 0x00FFFFFF);
+
+    // Ellipses covering the same pixels as drawEllipse() and fillEllipse()
+    void drawSmoothEllipse(int32_t x, int32_t y, int32_t rx, int32_t ry, uint32_t fg_color, uint32_t bg_color = 0x00FFFFFF),
+            fillSmoothEllipse(int32_t x, int32_t y, int32_t rx, int32_t ry, uint32_t color, uint32_t bg_color = 0x00FFFFFF);
+
+    // Arc from radius ir to radius r inclusive, drawn clockwise from startAngle to endAngle
+    // in degrees with 0 at 6 o'clock, 0 to 360 is a full ring. Ends are square unless roundEnds
+    void drawSmoothArc(int32_t x, int32_t y, int32_t r, int32_t ir, uint32_t startAngle, uint32_t endAngle,
+                       uint32_t fg_color, uint32_t bg_color = 0x00FFFFFF, bool roundEnds = false);
+
+    // Rounded rectangles covering the same pixels as drawRoundRect() and fillRoundRect()
+    void drawSmoothRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t radius, uint32_t color, uint32_t bg_color = 0x00FFFFFF),
+            fillSmoothRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t radius, uint32_t color, uint32_t bg_color = 0x00FFFFFF);
+
     // Image rendering
     // Swap the byte order for pushImage() and pushPixels() - corrects endianness
     void setSwapBytes(bool swap);
@@ -595,6 +688,14 @@ public:
             fontHeight(int16_t font),                        // Returns pixel height of string in specified font
     fontHeight(void);                                // Returns pixel width of string in current font
 
+    // Returns pixel width of string and the height of its glyphs above and below the baseline
+    int16_t textExtent(const char *string, uint8_t font, int16_t *ascent, int16_t *descent);
+
+    // Optional cache of measured strings for textWidth(), textExtent() and datum aligned drawString(),
+    // sized in entries, 0 (the default) turns it off. Returns false if the memory is not available
+    bool setTextWidthCache(uint16_t entries);
+    void getTextWidthCacheStats(uint32_t *hits, uint32_t *misses, bool reset = false);
+
     // Used by library and Smooth font class to extract Unicode point codes from a UTF8 encoded string
     uint16_t decodeUTF8(uint8_t *buf, uint16_t *index, uint16_t remaining),
             decodeUTF8(uint8_t c);
@@ -610,6 +711,9 @@ public:
     // Low level read/write
     void spiwrite(uint8_t);        // legacy support only
 
+    // setWindow() and drawPixel() do not resend CASET/PASET if the window is unchanged. Window
+    // commands must be sent with writecommand(), which clears that cache for the command sent,
+    // and followed by setAddrWindow() before pixels are pushed
     void writecommand(uint8_t c),  // Send a command, function resets DC/RS high ready for data
     writedata(uint8_t d);     // Send data with DC/RS set high
 
@@ -648,6 +752,9 @@ public:
 
 
     // DMA support functions - these are currently just for SPI writes when using the ESP32 or STM32 processors
+    // and for ESP32 8 bit parallel displays with TFT_PARALLEL_DMA, where the I2S peripheral in LCD mode sends one transfer at a time.
+    // For parallel displays the completion callback is called from dmaBusy()/dmaWait(), not an interrupt, and
+    // native colours (setSwapBytes(true)) are sent without a byte swap.
     // Bear in mind DMA will only be of benefit in particular circumstances and can be tricky
     // to manage by noobs. The functions have however been designed to be noob friendly and
     // avoid a few DMA behaviour "gotchas".
@@ -681,19 +788,42 @@ public:
     // Use the buffer if the image data will get over-written or destroyed while DMA is in progress
     // If swapping colour bytes is defined, and the double buffer option is NOT used, then the bytes
     // in the original data image will be swapped by the function before DMA is initiated.
-    // The function will wait for the last DMA to complete if it is called while a previous DMA is still
-    // in progress, this simplifies the sketch and helps avoid "gotchas".
-    void pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t *data, uint16_t *buffer = nullptr);
-
-    // Push a block of pixels into a window set up using setAddrWindow()
-    void pushPixelsDMA(uint16_t *image, uint32_t len);
+    // The window commands are queued ahead of the image so the function does not wait for a previous
+    // DMA to complete, unless the image is byte swapped in place and may still be in use. A clipped
+    // image without a buffer or byte swap is sent directly from "data" with one transfer per row.
+    // Returns a fence for the transfer, the optional "done" callback is called when it completes.
+    uint32_t pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t *data, uint16_t *buffer = nullptr,
+                          dmaDoneCallback done = nullptr, void *arg = nullptr);
+
+    // Queue the commands to set a window for pushPixelsDMA() without waiting for earlier DMA to complete
+    void setAddrWindowDMA(int32_t x, int32_t y, int32_t w, int32_t h);
+
+    // Push a block of pixels into a window set up using setAddrWindow() or setAddrWindowDMA()
+    // Up to DMA_QUEUE_SIZE transfers can be queued, the function only waits when all are in use
+    // Returns a fence for the transfer, the optional "done" callback is called when it completes.
+    // For 18 bit colour displays the pixels are copied into bounce buffers, so the image is not
+    // changed and can be re-used as soon as the function returns.
+    uint32_t pushPixelsDMA(uint16_t *image, uint32_t len, dmaDoneCallback done = nullptr, void *arg = nullptr);
+
+    // Stream a window of pixels rendered by a sketch callback in bands of "lines" rows. Two
+    // internal band buffers are used so the next band is rendered while the last is sent by
+    // DMA, a frame can then be updated without needing a frame buffer. Returns false if the
+    // window is off screen or the buffers could not be allocated. Blocks until all sent.
+    bool pushBandsDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t lines, dmaBandCallback fill);
 
     // Check if the DMA is complete - use while(tft.dmaBusy); for a blocking wait
     bool dmaBusy(void); // returns true if DMA is still in progress
     void dmaWait(void); // wait until DMA is complete
 
+    // Fences identify queued DMA transfers, they complete in the order they were queued. A "done"
+    // callback runs in the SPI interrupt so it must be short and in IRAM (IRAM_ATTR), e.g. it can
+    // give a FreeRTOS semaphore or notify a task that the buffer can now be re-used.
+    uint32_t dmaFence(void);              // returns the fence of the most recently queued transfer
+    bool dmaFenceDone(uint32_t fence);    // returns true if the fence transfer is complete
+    void dmaWaitFence(uint32_t fence);    // wait until the fence transfer is complete (blocking!)
+
     bool DMA_Enabled = false;   // Flag for DMA enabled state
-    uint8_t spiBusyCheck = 0;      // Number of ESP32 transfer buffers to check
+    uint8_t spiBusyCheck = 0;      // Number of ESP32 transfer slots queued and not yet retired
 
     // Bare metal functions
     void startWrite(void);                         // Begin SPI transaction
@@ -770,6 +900,28 @@ private:
     // Single GPIO input/output direction control
     void gpioMode(uint8_t gpio, uint8_t mode);
 
+#if defined (ESP32_DMA) && !defined (TFT_PARALLEL_8_BIT)
+    // DMA transaction queue slot management
+    spi_transaction_t *dmaSlot(void);                 // Get the next free slot, waits if queue is full
+    void dmaRetire(spi_transaction_t *rtrans);        // Release the oldest slot once complete
+    void dmaWaitQueue(uint8_t depth);                 // Wait until no more than depth slots are queued
+    void pushBlockDMA(uint16_t color, uint32_t len);  // Queue a solid colour fill from the fill buffer
+  #if defined (SPI_18BIT_DRIVER)
+    // Expand 16 bit pixels to 3 byte colours in bounce buffers and queue them, returns last fence
+    uint32_t dmaExpand666(const uint16_t *image, uint32_t len, dmaDoneCallback done, void *arg);
+  #endif
+    void dmaBytes(bool dc, uint32_t data, uint8_t len); // Queue a command (dc false) or up to 4 data bytes
+    // Queue a slot for transfer, returns its fence, "done" is called from the SPI interrupt on completion
+    uint32_t dmaQueue(spi_transaction_t *trans, dmaDoneCallback done = nullptr, void *arg = nullptr);
+#elif defined (ESP32_DMA)
+    // I2S DMA transfer management for 8 bit parallel, one transfer at a time
+    void dmaRetire(void);                             // Stop the completed transfer and release the bus
+    void dmaWaitQueue(uint8_t depth);                 // Wait until no more than depth transfers are active
+    void dmaPins(bool i2s);                           // Route data and WR pins to I2S or GPIO
+    // Start a transfer of len bytes, returns its fence, "done" is called when it is retired
+    uint32_t dmaStart(const uint8_t *data, uint32_t len, dmaDoneCallback done = nullptr, void *arg = nullptr);
+#endif
+
     // Display variant settings
     uint8_t tabcolor,                   // ST7735 screen protector "tab" colour (now invalid)
     colstart = 0, rowstart = 0; // Screen display area to CGRAM area coordinate offsets
@@ -794,7 +946,8 @@ uint32_t xset_mask[256]; // Makes Sprite rendering test 33% faster, for slower m
     //-------------------------------------- protected ----------------------------------//
 protected:
 
-    //int32_t  win_xe, win_ye;          // Window end coords - not needed
+    int32_t  win_xe, win_ye;           // Window end coords - used with addr_col/addr_row to minimise window commands
+    uint32_t winBytesSaved = 0;        // Count of window command bytes not sent because they were unchanged
 
     int32_t _init_width, _init_height; // Display w/h as input, used by setRotation()
     int32_t _width, _height;           // Display w/h as modified by current rotation
@@ -820,6 +973,98 @@ protected:
     glyph_bb;   // Smooth font glyph delta Y (height) below baseline
 
     bool isDigits;   // adjust bounding box for numbers to reduce visual jiggling
+
+    // Text width cache entry, keyed by string hash and length plus the font settings. The
+    // prefix and a second hash are checked on a hit so an FNV-1a collision is not returned.
+    typedef struct {
+        uint32_t hash;       // FNV-1a hash of the string and font
+        uint32_t check;      // One-at-a-time hash of the string
+        char prefix[8];      // First bytes of the string, zero padded
+        const void *face;    // Free font or smooth font metrics in use, else nullptr
+        uint16_t len;        // String length in bytes
+        uint8_t font;        // Font number
+        uint8_t size;        // textsize, bit 7 set for isDigits, 0 = empty entry
+        int16_t width, ascent, descent;
+    } textWidthEntry;
+
+    textWidthEntry *widthCache = nullptr; // Direct mapped by string hash, nullptr when off
+    uint16_t widthCacheSize = 0;
+    uint32_t widthCacheHits = 0, widthCacheMisses = 0;
+
+    void flushTextWidthCache(const void *face); // Remove entries measured with a font
+
+    // Display list item, a rectangle clipped to the viewport in TFT coordinates
+    typedef struct {
+        int16_t  x, y, w, h;
+        uint16_t color;
+    } dlItem;
+
+    dlItem   *dlList = nullptr;     // Recorded items, nullptr when off
+    uint16_t  dlSize = 0, dlCount = 0;
+    uint16_t *dlBand = nullptr;     // Band of native colour pixels, dlStride wide
+    uint8_t  *dlMask = nullptr;     // Bit per band pixel, set if an item covers it
+    uint16_t  dlStride = 0, dlBandRows = 0;
+    bool      dlRecording = false;
+    uint32_t  dlPixelsDrawn = 0, dlPixelsSent = 0;
+
+    void recordRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+    void drawDisplayList(void); // Draw and empty the list
+
+    // Filled shape rows with the same span are merged and drawn as one rectangle
+    typedef struct {
+        int32_t x0, x1, y, h;
+    } spanRun;
+
+    void pushSpan(spanRun &run, int32_t x0, int32_t x1, int32_t y, uint32_t color);
+
+    // Filled circles, ellipses and rounded rectangles record the half width of each visible
+    // row, so rows can be drawn in order and merged whatever order the algorithm finds them
+    typedef struct {
+        int32_t  y0, rows; // First row and row count
+        int32_t *hw;       // Half width of each row, the widest one found is kept
+    } spanTable;
+
+    bool clipSpanRows(int32_t &ys, int32_t &ye);
+    void clearSpans(spanTable &t);
+    void drawSpans(const spanTable &t, int32_t xl, int32_t xr, uint32_t color);
+
+    inline void addSpan(spanTable &t, int32_t y, int32_t hw) __attribute__((always_inline));
+
+    // Partly covered anti-aliased pixels are collected in runs along a row or column
+    typedef struct {
+        int32_t  x, y;       // First pixel
+        uint16_t n;          // Pixel count, 0 = empty
+        bool     vertical;   // Run is down a column
+        uint8_t  alpha[64];
+    } alphaRun;
+
+    void addAlpha(alphaRun &run, int32_t x, int32_t y, uint8_t alpha, uint32_t fg, uint32_t bg);
+    void blendAlphaRun(const alphaRun &run, uint32_t fg, uint32_t bg, uint16_t *buf);
+    virtual void pushAlphaRun(alphaRun &run, uint32_t fg, uint32_t bg); // Draws and empties a run
+
+    // Anti-aliased shapes are scanned row by row using the signed distance to their edge
+    enum { aaWedge, aaArc, aaBox, aaEllipse };
+
+    typedef struct {
+        uint8_t type;
+        bool    full;            // Arc is a whole ring, box or ellipse is filled
+        bool    wide;            // Arc sweep is over 180 degrees
+        bool    roundEnds;       // Arc has round end caps
+        float   x, y;            // Wedge start, arc, box or ellipse centre
+        float   r0, r1;          // Wedge end radii, arc outer and inner edge, box corner radius, ellipse outer semi-axes
+        float   ux, uy, vx, vy;  // Wedge length and side, arc start and end direction, box half size, ellipse inner semi-axes
+        float   h;               // Wedge length squared (0 = circle), arc end cap radius, box outline width
+        int32_t x0, y0, x1, y1;  // Bounding box
+    } aaShape;
+
+    float aaDistance(const aaShape &s, float px, float py);
+    void  drawSmoothShape(const aaShape &s, uint32_t fg, uint32_t bg);
+
+#ifdef LOAD_GLCD
+    // Draw a GLCD font string and its padding x0 to x1 in one window, returns false
+    // if the string must be drawn character by character
+    virtual bool drawStringGlcd(const char *string, int32_t poX, int32_t poY, int32_t x0, int32_t x1);
+#endif
     bool textwrapX, textwrapY;  // If set, 'wrap' text at right and optionally bottom edge of display
     bool _swapBytes; // Swap the byte order for TFT pushImage()
     bool locked, inTransaction, lockTransaction; // SPI transaction and mutex lock flags
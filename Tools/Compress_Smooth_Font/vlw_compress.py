@@ -0,0 +1,185 @@
+'''
+
+    This script takes in a smooth font .vlw file (made by Create_font.pde) and
+    outputs a compact version of the font with 4 bit alpha and run length
+    encoded glyph bitmaps. The compact font is loaded with loadFont() in the
+    same way as a .vlw file or array, the library detects the format.
+
+    You'll need python 3.6
+
+    usage: python vlw_compress.py [-v] Final-Frontier28.vlw [-o myfont.vlw] [-c] [-k pairs.txt]
+
+    The -c option writes a C array (.h file) for use with loadFont(array).
+
+    The -k option adds kerning pairs from a text file, one pair per line:
+        left right adjust
+    where left and right are characters or 0xNNNN Unicode values and adjust is
+    the signed change in pixels to the advance between them, e.g. "A V -2".
+    Lines starting with # are comments.
+
+    Compact format, all values are big endian uint32_t as in a .vlw file:
+
+    . Header of 6 values, the same as .vlw except the version is 0x52 ('R')
+      and the 4th value is the number of kerning pairs
+    . Metrics of 7 values per glyph, the same as .vlw except the 7th value
+      (padding, always 0 in .vlw) is the glyph bitmap offset from the start
+      of the bitmap area (24 + 28 * glyph count + 8 * kerning pairs)
+    . Kerning pairs of 2 values, left << 16 | right then the signed adjust,
+      sorted by the first value
+    . Glyph bitmaps, each row is coded as runs, one byte per run:
+        upper 4 bits = alpha (0-15, 15 = opaque), lower 4 bits = run length - 1
+      Runs do not cross rows
+    . The font name strings that follow the bitmaps in the .vlw are copied
+
+'''
+
+import sys
+import struct
+import argparse
+import os
+
+COMPACT_VERSION = 0x52
+
+debug = None
+
+def debugOut(s):
+    if debug:
+        print(s)
+
+def parseCode(s):
+    if len(s) > 2 and s[:2].lower() == "0x":
+        return int(s, 16)
+    if len(s) != 1:
+        raise ValueError(s)
+    return ord(s)
+
+def readKerning(fileName, codes):
+    pairs = {}
+    with open(fileName, "r", encoding="utf-8") as f:
+        for lineNum, line in enumerate(f, 1):
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            try:
+                left, right, adjust = line.split()
+                left = parseCode(left)
+                right = parseCode(right)
+                adjust = int(adjust)
+            except ValueError:
+                print("{} line {}: expected 'left right adjust'".format(fileName, lineNum))
+                sys.exit(1)
+            if adjust < -128 or adjust > 127:
+                print("{} line {}: adjust must be -128 to 127".format(fileName, lineNum))
+                sys.exit(1)
+            if left not in codes or right not in codes:
+                debugOut("Skipping pair 0x{:04X} 0x{:04X}, not in font".format(left, right))
+                continue
+            if adjust:
+                pairs[left << 16 | right] = adjust
+    return sorted(pairs.items())
+
+def encodeGlyph(alpha, width, height):
+    out = bytearray()
+    for y in range(height):
+        row = alpha[y * width:(y + 1) * width]
+        x = 0
+        while x < width:
+            a = (row[x] + 8) // 17 # 8 bit to 4 bit alpha, rounded
+            run = 1
+            while (x + run < width) and (run < 16) and ((row[x + run] + 8) // 17 == a):
+                run += 1
+            out.append(a << 4 | (run - 1))
+            x += run
+    return out
+
+# look at arguments
+parser = argparse.ArgumentParser(description="Convert a .vlw smooth font to the compact 4 bit run length encoded format")
+parser.add_argument("-v", "--verbose", help="debug output", action="store_true")
+parser.add_argument("input", help="input .vlw file name")
+parser.add_argument("-o", "--output", help="output file name")
+parser.add_argument("-c", "--carray", help="write a C array header instead of a binary file", action="store_true")
+parser.add_argument("-k", "--kerning", help="text file of kerning pairs")
+args = parser.parse_args()
+
+if not os.path.exists(args.input):
+    parser.print_help()
+    print("The input file {} does not exist".format(args.input))
+    sys.exit(1)
+
+name = os.path.splitext(os.path.basename(args.input))[0]
+
+if args.output == None:
+    output = name + ("_compact.h" if args.carray else "_compact.vlw")
+else:
+    output = args.output
+
+debug = args.verbose
+
+try:
+    infile = open(args.input, "rb")
+    contents = bytearray(infile.read())
+    infile.close()
+except:
+    print("could not read input file {}".format(args.input))
+    sys.exit(1)
+
+header = list(struct.unpack(">6I", contents[0:24]))
+gCount = header[0]
+debugOut("Glyphs: {}, version: 0x{:X}".format(gCount, header[1]))
+
+if header[1] == COMPACT_VERSION:
+    print("{} is already a compact font".format(args.input))
+    sys.exit(1)
+
+metrics = []
+for i in range(gCount):
+    metrics.append(list(struct.unpack(">7I", contents[24 + 28 * i:24 + 28 * (i + 1)])))
+
+# Encode the bitmaps and set the offset of each one
+upto = 24 + 28 * gCount
+bitmaps = bytearray()
+for m in metrics:
+    height = m[1]
+    width = m[2]
+    size = width * height
+    m[6] = len(bitmaps)
+    bitmaps += encodeGlyph(contents[upto:upto + size], width, height)
+    upto += size
+
+kerning = []
+if args.kerning:
+    if not os.path.exists(args.kerning):
+        print("The kerning file {} does not exist".format(args.kerning))
+        sys.exit(1)
+    kerning = readKerning(args.kerning, set(m[0] for m in metrics))
+    debugOut("Kerning pairs: {}".format(len(kerning)))
+
+header[1] = COMPACT_VERSION
+header[3] = len(kerning)
+
+data = bytearray(struct.pack(">6I", *header))
+for m in metrics:
+    data += struct.pack(">7I", *m)
+for pair, adjust in kerning:
+    data += struct.pack(">Ii", pair, adjust)
+data += bitmaps
+data += contents[upto:] # Font name strings
+
+print("{}: {} bytes, compact: {} bytes ({}%)".format(args.input, len(contents), len(data), len(data) * 100 // len(contents)))
+
+try:
+    if args.carray:
+        outfile = open(output, "w")
+        outfile.write("// Compact smooth font made by vlw_compress.py from {}\n\n".format(os.path.basename(args.input)))
+        outfile.write("#include <pgmspace.h>\n\n")
+        outfile.write("const uint8_t {}[] PROGMEM = {{\n".format(name.replace("-", "_")))
+        for i in range(0, len(data), 16):
+            outfile.write("  " + ", ".join("0x{:02X}".format(b) for b in data[i:i + 16]) + ",\n")
+        outfile.write("};\n")
+    else:
+        outfile = open(output, "wb")
+        outfile.write(data)
+    outfile.close()
+except:
+    print("could not write output file {}".format(output))
+    sys.exit(1)
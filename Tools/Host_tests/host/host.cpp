@@ -0,0 +1,526 @@
+// Host implementations of the Arduino and ESP-IDF functions used by TFT_eSPI
+#include <chrono>
+#include <deque>
+#include <malloc.h>
+#include <Arduino.h>
+#include <SPI.h>
+#include <SPIFFS.h>
+#include <esp_heap_caps.h>
+#include <soc/spi_reg.h>
+#include <User_Setup.h>
+#if defined (TFT_PARALLEL_DMA)
+  #include <soc/i2s_struct.h>
+  #include <soc/gpio_sig_map.h>
+  #include <driver/periph_ctrl.h>
+  #include <rom/lldesc.h>
+  #include <rom/gpio.h>
+#endif
+#include "host.h"
+
+HardwareSerial Serial;
+SPIClass SPI;
+SPIFFSFS SPIFFS;
+
+uint32_t host_spi_regs[4][64];
+uint32_t host_io_mux[64];
+volatile gpio_dev_t GPIO;
+const esp32_gpioMux_t esp32_gpioMux[40] = {};
+
+uint16_t host_panel[HOST_PANEL_SIZE][HOST_PANEL_SIZE];
+host_bus_stats host_bus;
+host_dma_stats host_dma;
+uint64_t host_time_ns = 0;
+bool host_dma_log_on = false;
+std::vector<const spi_transaction_t*> host_dma_log;
+int host_failures = 0;
+int host_files_open = 0;
+int64_t host_heap_used = 0;
+int host_file_reads_selected = 0;
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Arduino core
+////////////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t gpioLevel = 0;
+
+uint64_t host_micros(void)
+{
+  using namespace std::chrono;
+  static const steady_clock::time_point start = steady_clock::now();
+  return duration_cast<microseconds>(steady_clock::now() - start).count();
+}
+
+void     pinMode(uint8_t, uint8_t) {}
+void     digitalWrite(uint8_t pin, uint8_t val) { if (pin < 32) host_gpio_write(val ? 1u << pin : 0, val ? 0 : 1u << pin); }
+int      digitalRead(uint8_t pin) { return pin < 32 ? (gpioLevel >> pin) & 1 : 0; }
+void     delay(uint32_t) {}
+void     delayMicroseconds(uint32_t) {}
+void     yield(void) {}
+uint32_t millis(void) { return host_micros() / 1000; }
+uint32_t micros(void) { return host_micros(); }
+long     random(long howbig) { return howbig > 0 ? rand() % howbig : 0; }
+long     random(long howsmall, long howbig) { return howsmall + random(howbig - howsmall); }
+bool     psramFound(void) { return false; }
+void*    ps_malloc(size_t size) { return malloc(size); }
+void*    ps_calloc(size_t n, size_t size) { return calloc(n, size); }
+
+char* ltoa(long val, char* s, int radix)
+{
+  if (radix == 16) sprintf(s, "%lx", val);
+  else sprintf(s, "%ld", val);
+  return s;
+}
+
+char* ultoa(unsigned long val, char* s, int radix)
+{
+  if (radix == 16) sprintf(s, "%lx", val);
+  else sprintf(s, "%lu", val);
+  return s;
+}
+
+char* dtostrf(double val, signed char width, unsigned char prec, char* s)
+{
+  sprintf(s, "%*.*f", width, prec, val);
+  return s;
+}
+
+size_t Print::print(const String& s) { return write(s.c_str()); }
+
+// Allocations are counted by linking with --wrap, see run_tests.sh
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t n, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void  __real_free(void* ptr);
+
+void* __wrap_malloc(size_t size)
+{
+  void* ptr = __real_malloc(size);
+  if (ptr) host_heap_used += malloc_usable_size(ptr);
+  return ptr;
+}
+
+void* __wrap_calloc(size_t n, size_t size)
+{
+  void* ptr = __real_calloc(n, size);
+  if (ptr) host_heap_used += malloc_usable_size(ptr);
+  return ptr;
+}
+
+void* __wrap_realloc(void* ptr, size_t size)
+{
+  if (ptr) host_heap_used -= malloc_usable_size(ptr);
+  ptr = __real_realloc(ptr, size);
+  if (ptr) host_heap_used += malloc_usable_size(ptr);
+  return ptr;
+}
+
+void __wrap_free(void* ptr)
+{
+  if (ptr) host_heap_used -= malloc_usable_size(ptr);
+  __real_free(ptr);
+}
+}
+
+// DMA capable blocks are recorded so the I2S model can find descriptors from their address
+static std::vector<std::pair<uint8_t*, size_t>> dmaHeap;
+
+static void* dmaCapable(void* ptr, size_t size, uint32_t caps)
+{
+  if (ptr && (caps & MALLOC_CAP_DMA)) dmaHeap.push_back({ (uint8_t*)ptr, size });
+  return ptr;
+}
+
+void* heap_caps_malloc(size_t size, uint32_t caps) { return dmaCapable(malloc(size), size, caps); }
+void* heap_caps_calloc(size_t n, size_t size, uint32_t caps) { return dmaCapable(calloc(n, size), n * size, caps); }
+
+void heap_caps_free(void* ptr)
+{
+  for (size_t i = 0; i < dmaHeap.size(); i++)
+    if (dmaHeap[i].first == ptr) { dmaHeap.erase(dmaHeap.begin() + i); break; }
+  free(ptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Files
+////////////////////////////////////////////////////////////////////////////////////////
+
+static std::string fsRoot = ".";
+
+void host_fs_root(const char* dir) { fsRoot = dir; }
+
+void host_file_access(void)
+{
+  if (!(gpioLevel & (1u << TFT_CS))) host_file_reads_selected++;
+}
+
+fs::File fs::FS::open(const char* path, const char* mode)
+{
+  FILE* f = fopen((fsRoot + path).c_str(), *mode == 'w' ? "wb" : "rb");
+  return f ? fs::File(f) : fs::File();
+}
+
+bool fs::FS::exists(const char* path)
+{
+  FILE* f = fopen((fsRoot + path).c_str(), "rb");
+  if (f) fclose(f);
+  return f != nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Display memory model, decodes the window and memory write commands
+////////////////////////////////////////////////////////////////////////////////////////
+
+static uint8_t  cmd = 0;
+static uint8_t  param[4];
+static uint32_t paramCount = 0;
+static uint16_t colStart = 0, colEnd = 0, rowStart = 0, rowEnd = 0;
+static uint16_t col = 0, row = 0;
+
+void host_panel_clear(uint16_t color)
+{
+  for (int y = 0; y < HOST_PANEL_SIZE; y++)
+    for (int x = 0; x < HOST_PANEL_SIZE; x++) host_panel[y][x] = color;
+  host_bus = host_bus_stats();
+}
+
+static void busByte(uint8_t b, bool dc)
+{
+  if (!dc)
+  {
+    host_bus.commands++;
+    cmd = b;
+    paramCount = 0;
+    col = colStart;
+    row = rowStart;
+    return;
+  }
+
+  host_bus.data++;
+
+  if (cmd == 0x2A || cmd == 0x2B) // CASET, RASET
+  {
+    if (paramCount < 4) param[paramCount++] = b;
+    if (paramCount == 4)
+    {
+      uint16_t s = param[0] << 8 | param[1];
+      uint16_t e = param[2] << 8 | param[3];
+      if (cmd == 0x2A) { colStart = s; colEnd = e; }
+      else             { rowStart = s; rowEnd = e; }
+    }
+  }
+  else if (cmd == 0x2C) // RAMWR, two bytes per pixel, most significant first
+  {
+    if (paramCount++ & 1)
+    {
+      if (col < HOST_PANEL_SIZE && row < HOST_PANEL_SIZE) host_panel[row][col] = param[0] << 8 | b;
+      host_bus.pixels++;
+      if (col++ >= colEnd) { col = colStart; if (row++ >= rowEnd) row = rowStart; }
+    }
+    else param[0] = b;
+  }
+}
+
+#if defined (TFT_PARALLEL_DMA)
+static void i2sGpioWrite(uint32_t changed);
+#endif
+
+void host_gpio_write(uint32_t set, uint32_t clr)
+{
+  uint32_t old = gpioLevel;
+  gpioLevel = (gpioLevel & ~clr) | set;
+
+#if defined (TFT_PARALLEL_DMA)
+  i2sGpioWrite(gpioLevel ^ old);
+#endif
+
+#if defined (TFT_PARALLEL_8_BIT)
+  // A byte is written on the rising edge of WR
+  if ((gpioLevel & ~old) & (1u << TFT_WR))
+  {
+    const uint8_t pin[8] = { TFT_D0, TFT_D1, TFT_D2, TFT_D3, TFT_D4, TFT_D5, TFT_D6, TFT_D7 };
+    uint8_t b = 0;
+    for (int i = 0; i < 8; i++) if (gpioLevel & (1u << pin[i])) b |= 1 << i;
+    busByte(b, gpioLevel & (1u << TFT_DC));
+  }
+#else
+  (void)old;
+#endif
+}
+
+uint32_t gpio_input_get(void) { return gpioLevel; }
+
+////////////////////////////////////////////////////////////////////////////////////////
+// SPI master driver with a simulated bus clock
+////////////////////////////////////////////////////////////////////////////////////////
+
+struct queued {
+  spi_transaction_t* trans;
+  uint64_t end;   // Time the last bit is sent
+  bool     done;  // Callbacks have run
+};
+
+static std::deque<queued> dmaQueue; // Queued or finished but not yet returned
+static int      queueSize = 0;
+static uint32_t clockHz = 1;
+static uint64_t busFree = 0;
+static transaction_cb_t preCb = nullptr, postCb = nullptr;
+
+// Run the callbacks of every transaction that has ended, in queue order
+static void dmaAdvance(void)
+{
+  for (queued& q : dmaQueue)
+  {
+    if (q.done) continue;
+    if (q.end > host_time_ns) break;
+
+    spi_transaction_t* t = q.trans;
+    if (preCb) preCb(t); // Sets DC
+
+    const uint8_t* p = (t->flags & SPI_TRANS_USE_TXDATA) ? t->tx_data : (const uint8_t*)t->tx_buffer;
+    bool dc = gpioLevel & (1u << TFT_DC);
+    for (size_t i = 0; i < t->length / 8; i++) busByte(p[i], dc);
+
+    q.done = true;
+    host_dma.completed++;
+    if (postCb) postCb(t);
+  }
+}
+
+#if defined (TFT_PARALLEL_DMA)
+static void i2sAdvance(void);
+#endif
+
+void host_cpu(uint64_t ns)
+{
+  host_time_ns += ns;
+  dmaAdvance();
+#if defined (TFT_PARALLEL_DMA)
+  i2sAdvance();
+#endif
+}
+
+void host_dma_reset(void)
+{
+  if (!dmaQueue.empty()) { fprintf(stderr, "host_dma_reset: transactions are queued\n"); abort(); }
+  host_dma = host_dma_stats();
+  host_dma_log.clear();
+}
+
+esp_err_t spi_bus_initialize(spi_host_device_t, const spi_bus_config_t*, int) { return ESP_OK; }
+esp_err_t spi_bus_free(spi_host_device_t) { return ESP_OK; }
+
+esp_err_t spi_bus_add_device(spi_host_device_t, const spi_device_interface_config_t* dev, spi_device_handle_t* handle)
+{
+  queueSize = dev->queue_size;
+  clockHz   = dev->clock_speed_hz;
+  preCb     = dev->pre_cb;
+  postCb    = dev->post_cb;
+  *handle   = (spi_device_handle_t)&dmaQueue;
+  return ESP_OK;
+}
+
+esp_err_t spi_bus_remove_device(spi_device_handle_t)
+{
+  if (!dmaQueue.empty()) { fprintf(stderr, "spi_bus_remove_device: transactions are queued\n"); abort(); }
+  return ESP_OK;
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t, spi_transaction_t* trans, TickType_t)
+{
+  // The driver would block here, the library must never queue more than its queue size
+  if ((int)dmaQueue.size() >= queueSize) { fprintf(stderr, "spi_device_queue_trans: queue full\n"); abort(); }
+
+  for (queued& q : dmaQueue)
+    if (q.trans == trans) { fprintf(stderr, "spi_device_queue_trans: transaction already queued\n"); abort(); }
+
+  uint64_t start = (busFree > host_time_ns) ? busFree : host_time_ns;
+  uint64_t ns = (uint64_t)trans->length * 1000000000ull / clockHz;
+  busFree = start + ns;
+  dmaQueue.push_back({ trans, busFree, false });
+
+  host_dma.queued++;
+  host_dma.bits += trans->length;
+  host_dma.busy_ns += ns;
+  if (dmaQueue.size() > host_dma.max_depth) host_dma.max_depth = dmaQueue.size();
+  if (host_dma_log_on) host_dma_log.push_back(trans);
+
+  dmaAdvance();
+  return ESP_OK;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t, spi_transaction_t** trans, TickType_t wait)
+{
+  dmaAdvance();
+
+  if (dmaQueue.empty())
+  {
+    if (wait == portMAX_DELAY) { fprintf(stderr, "spi_device_get_trans_result: nothing queued\n"); abort(); }
+    return ESP_ERR_TIMEOUT;
+  }
+
+  if (!dmaQueue.front().done)
+  {
+    if (wait == 0) { host_cpu(1000); return ESP_ERR_TIMEOUT; } // A poll takes some time
+    host_cpu(dmaQueue.front().end - host_time_ns);
+  }
+
+  *trans = dmaQueue.front().trans;
+  dmaQueue.pop_front();
+  return ESP_OK;
+}
+
+#if defined (TFT_PARALLEL_DMA)
+////////////////////////////////////////////////////////////////////////////////////////
+// I2S0 in LCD mode for 8 bit parallel DMA, one transfer at a time
+////////////////////////////////////////////////////////////////////////////////////////
+
+volatile i2s_dev_t I2S0;
+int host_i2s_enabled = 0;
+
+static uint32_t matrixOut[40];  // GPIO matrix output signal of each pin
+static bool     matrixInv[40];
+
+static const uint8_t busPin[8] = { TFT_D0, TFT_D1, TFT_D2, TFT_D3, TFT_D4, TFT_D5, TFT_D6, TFT_D7 };
+
+static bool     i2sRunning = false; // tx_start is set
+static bool     i2sSent = false;    // The last descriptor has been sent
+static uint64_t i2sEnd = 0;
+static uint32_t i2sRaw = 0;
+static bool     i2sDc = false;
+static std::vector<lldesc_t*> i2sChain;
+
+static void i2sFail(const char* msg)
+{
+  fprintf(stderr, "I2S: %s\n", msg);
+  abort();
+}
+
+void gpio_matrix_out(uint32_t gpio, uint32_t signal_idx, bool out_inv, bool)
+{
+  if (gpio >= 40) i2sFail("gpio_matrix_out: no such pin");
+  matrixOut[gpio] = signal_idx;
+  matrixInv[gpio] = out_inv;
+}
+
+void periph_module_enable(periph_module_t) { host_i2s_enabled++; }
+void periph_module_disable(periph_module_t) { host_i2s_enabled--; }
+
+static bool routedToI2S(void)
+{
+  return matrixOut[TFT_WR] == I2S0O_WS_OUT_IDX;
+}
+
+// The CPU cannot drive the bus while the data and WR pins are routed to the I2S peripheral,
+// and DC or CS must not change while the I2S peripheral is sending
+static void i2sGpioWrite(uint32_t changed)
+{
+  if (routedToI2S() && (changed & (1u << TFT_WR))) i2sFail("WR written by the CPU while routed to I2S");
+  if (i2sRunning && !i2sSent && (changed & ((1u << TFT_DC) | (1u << TFT_CS)))) i2sFail("DC or CS changed during a transfer");
+}
+
+// Find a descriptor from the low 20 bits of its address, it must be in DMA capable memory
+static lldesc_t* i2sDescriptor(uintptr_t addr)
+{
+  for (auto& block : dmaHeap)
+    for (size_t i = 0; i + sizeof(lldesc_t) <= block.second; i += sizeof(lldesc_t))
+      if (((uintptr_t)(block.first + i) & 0xFFFFF) == addr) return (lldesc_t*)(block.first + i);
+  return nullptr;
+}
+
+static bool inDmaHeap(const lldesc_t* d)
+{
+  for (auto& block : dmaHeap)
+    if ((uint8_t*)d >= block.first && (uint8_t*)(d + 1) <= block.first + block.second) return true;
+  return false;
+}
+
+// Bytes reach the panel when the transfer ends, the buffers must not be changed before then.
+// In 8 bit mode each pair of bytes is sent in reverse order, the second byte first
+static void i2sAdvance(void)
+{
+  if (!i2sRunning || i2sSent || host_time_ns < i2sEnd) return;
+
+  for (lldesc_t* d : i2sChain)
+  {
+    const uint8_t* p = (const uint8_t*)d->buf;
+    for (uint32_t i = 0; i < d->length; i += 2) { busByte(p[i + 1], i2sDc); busByte(p[i], i2sDc); }
+    d->owner = 0;
+  }
+
+  i2sSent = true;
+  i2sRaw |= I2S_OUT_TOTAL_EOF_INT_RAW;
+  host_dma.completed++;
+}
+
+void host_i2s_tx_start(uint32_t v)
+{
+  if (!v)
+  {
+    if (i2sRunning && !i2sSent) i2sFail("transfer stopped before the end");
+    i2sRunning = false;
+    return;
+  }
+
+  if (i2sRunning) i2sFail("transfer started while one is running");
+  if (host_i2s_enabled <= 0) i2sFail("peripheral is not enabled");
+  if (!I2S0.out_link.start) i2sFail("descriptor link not started");
+  if (i2sRaw & I2S_OUT_TOTAL_EOF_INT_RAW) i2sFail("end of frame flag not cleared");
+  if (gpioLevel & (1u << TFT_CS)) i2sFail("transfer started with TFT_CS high");
+  for (uint8_t i = 0; i < 8; i++)
+    if (matrixOut[busPin[i]] != (uint32_t)I2S0O_DATA_OUT16_IDX + i || matrixInv[busPin[i]]) i2sFail("data pin not routed to I2S");
+  if (!routedToI2S() || !matrixInv[TFT_WR]) i2sFail("WR not routed to the inverted WS clock");
+  I2S0.out_link.start = 0;
+
+  // Walk the descriptor list, checking each one as the DMA engine would
+  i2sChain.clear();
+  uint32_t bytes = 0;
+  lldesc_t* d = i2sDescriptor(I2S0.out_link.addr);
+  if (!d) i2sFail("out_link.addr is not a descriptor in DMA capable memory");
+  while (true)
+  {
+    if (!inDmaHeap(d)) i2sFail("descriptor is not in DMA capable memory");
+    if (!d->owner) i2sFail("descriptor is not owned by DMA");
+    if (!d->buf || !d->length || d->length > d->size || (d->length & 1)) i2sFail("bad descriptor length or buffer");
+    if (i2sChain.size() > 1000) i2sFail("descriptor list does not end");
+    i2sChain.push_back(d);
+    bytes += d->length;
+    if (d->eof) break;
+    d = d->qe.stqe_next;
+    if (!d) i2sFail("descriptor list ends without eof");
+  }
+
+  // The WR strobe runs at 80MHz / (2 * TFT_I2S_CLK_DIV), so a byte takes 25ns * TFT_I2S_CLK_DIV
+  uint64_t ns = (uint64_t)bytes * 25 * TFT_I2S_CLK_DIV;
+  i2sEnd = host_time_ns + ns;
+  i2sRunning = true;
+  i2sSent = false;
+  i2sDc = gpioLevel & (1u << TFT_DC);
+
+  host_dma.queued++;
+  host_dma.bits += bytes * 8;
+  host_dma.busy_ns += ns;
+  host_dma.max_depth = 1;
+}
+
+uint32_t host_i2s_int_raw(void)
+{
+  if (i2sRunning && !i2sSent) host_cpu(1000); // A poll takes some time
+  return i2sRaw;
+}
+
+bool host_i2s_tx_idle(void) { return !i2sRunning || i2sSent; }
+
+void host_i2s_int_clr(uint32_t v) { i2sRaw &= ~v; }
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Results
+////////////////////////////////////////////////////////////////////////////////////////
+
+int host_result(const char* name)
+{
+  if (host_files_open) { fprintf(stderr, "%d files left open\n", host_files_open); host_failures++; }
+  printf("%s: %s\n", name, host_failures ? "FAIL" : "pass");
+  return host_failures ? 1 : 0;
+}
@@ -0,0 +1,71 @@
+// Host test support for TFT_eSPI, see ../README.md
+//
+// Bytes sent to the TFT are decoded by a model of the display memory (host_panel). On
+// a parallel build every byte is seen, as the write strobe is followed on the GPIO
+// registers. On an SPI build only DMA transactions are seen, register transfers are not.
+//
+// SPI DMA transactions are completed in queue order against a simulated clock: each one
+// takes its length in bits at the SPI clock rate from when the bus is free. Time only
+// advances when the sketch waits for a transaction or calls host_cpu().
+//
+// With TFT_PARALLEL_DMA the I2S0 peripheral is modelled: a transfer walks the descriptor
+// list from out_link.addr, takes 25ns * TFT_I2S_CLK_DIV per byte and sends each pair of
+// bytes in reverse order, as the ESP32 TRM describes for 8 bit LCD mode (not checked on
+// hardware). Misuse of the peripheral or of the routed bus pins aborts the test.
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include <driver/spi_master.h>
+
+// Display memory, indexed [row][column] as addressed by CASET/RASET
+#define HOST_PANEL_SIZE 256
+extern uint16_t host_panel[HOST_PANEL_SIZE][HOST_PANEL_SIZE];
+
+struct host_bus_stats {
+  uint32_t commands;  // Command bytes
+  uint32_t data;      // Data bytes, including window coordinates
+  uint32_t pixels;    // Pixels written to display memory
+};
+extern host_bus_stats host_bus;
+
+void host_panel_clear(uint16_t color = 0); // Also resets host_bus
+
+// Simulated time in ns, host_cpu() adds CPU work and completes any transfers that end
+extern uint64_t host_time_ns;
+void host_cpu(uint64_t ns);
+
+struct host_dma_stats {
+  uint32_t queued;       // Transactions queued
+  uint32_t completed;    // Transactions sent
+  uint32_t max_depth;    // Most transactions queued or not yet returned at one time
+  uint64_t bits;         // Bits sent
+  uint64_t busy_ns;      // Time the bus was sending
+};
+extern host_dma_stats host_dma;
+
+// Transactions in the order they were queued, kept while host_dma_log_on is true
+extern bool host_dma_log_on;
+extern std::vector<const spi_transaction_t*> host_dma_log;
+
+void host_dma_reset(void); // Clears the stats and log, transactions must not be queued
+
+// I2S0 enables less disables, I2S transfers are counted in host_dma
+extern int host_i2s_enabled;
+
+// File reads and seeks made while TFT_CS is low, when the TFT holds the bus
+extern int host_file_reads_selected;
+
+// Bytes allocated now with malloc(), calloc() and realloc() called from the library and tests
+extern int64_t host_heap_used;
+
+// Host time for benchmarks, in microseconds
+uint64_t host_micros(void);
+
+// Check a condition, print and count a failure if it is false
+extern int host_failures;
+#define HOST_CHECK(c) do { if (!(c)) { host_failures++; \
+  fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #c); } } while (0)
+
+// Print a result line and return the exit code for main()
+int host_result(const char* name);
@@ -0,0 +1,59 @@
+#!/bin/sh
+# Build TFT_eSPI for the host PC and run the tests, see README.md
+#
+#   ./run_tests.sh              build and run every test in tests/
+#   ./run_tests.sh spi_dma_ring build and run one test
+#
+# Tests named spi_* use an SPI display, par_* an 8 bit parallel display and i2s_* an
+# 8 bit parallel display with I2S DMA (TFT_PARALLEL_DMA).
+# SANITIZE=1 builds with the address and undefined behaviour sanitizers.
+
+cd "$(dirname "$0")" || exit 1
+
+CXX=${CXX:-g++}
+OUT=build
+FLAGS="-std=gnu++17 -O2 -g -DESP32 -Istubs -Ihost"
+if [ -n "$SANITIZE" ]; then FLAGS="$FLAGS -fsanitize=address,undefined"; fi
+
+# Heap use of the library and tests is counted by the wrappers in host.cpp
+WRAP="-Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free"
+
+if [ $# -eq 0 ]; then
+  set -- $(cd tests && ls *.cpp | sed 's/\.cpp$//')
+fi
+
+mkdir -p $OUT
+failed=0
+built=""
+
+for name in "$@"; do
+  case $name in
+    spi_*) bus=spi ;;
+    par_*) bus=parallel ;;
+    i2s_*) bus=i2s ;;
+    *) echo "$name: unknown bus, test names start spi_, par_ or i2s_"; failed=$((failed + 1)); continue ;;
+  esac
+
+  # The library and host code are built once for each bus
+  case " $built " in
+    *" $bus "*) ;;
+    *)
+      echo "Building library for $bus bus"
+      mkdir -p $OUT/$bus
+      $CXX $FLAGS -w -Isetup/$bus -I../.. -c ../../TFT_eSPI.cpp -o $OUT/$bus/TFT_eSPI.o &&
+      $CXX $FLAGS -Wall -Isetup/$bus -I../.. -c host/host.cpp -o $OUT/$bus/host.o || exit 1
+      built="$built $bus" ;;
+  esac
+
+  if $CXX $FLAGS -Wall -Isetup/$bus -I../.. -o $OUT/$name tests/$name.cpp $OUT/$bus/TFT_eSPI.o $OUT/$bus/host.o $WRAP; then
+    (cd $OUT && ./$name) || failed=$((failed + 1))
+  else
+    failed=$((failed + 1))
+  fi
+done
+
+if [ $failed -ne 0 ]; then
+  echo "$failed test(s) failed"
+  exit 1
+fi
+echo "All tests passed"
@@ -0,0 +1,31 @@
+// Host test setup, ST7735 128 x 160 on the ESP32 8 bit parallel bus with I2S DMA
+#define ST7735_DRIVER
+#define ST7735_REDTAB
+#define TFT_WIDTH  128
+#define TFT_HEIGHT 160
+
+#define TFT_PARALLEL_8_BIT
+#define TFT_PARALLEL_DMA
+#define TFT_I2S_CLK_DIV 4 // Also read by the host I2S model
+
+#define TFT_CS   15
+#define TFT_DC   12
+#define TFT_RST  -1
+#define TFT_WR    4
+#define TFT_RD    2
+
+#define TFT_D0   16
+#define TFT_D1   17
+#define TFT_D2   18
+#define TFT_D3   19
+#define TFT_D4   21
+#define TFT_D5   22
+#define TFT_D6   23
+#define TFT_D7   25
+
+#define LOAD_GLCD
+#define LOAD_GFXFF
+#define SMOOTH_FONT
+
+// Strings the width of the screen are drawn in several bands
+#define SMOOTH_STRIP_PIXELS 1024
@@ -0,0 +1,15 @@
+// Host test setup, ST7735 128 x 160 on the ESP32 SPI bus
+#define ST7735_DRIVER
+#define ST7735_REDTAB
+#define TFT_WIDTH  128
+#define TFT_HEIGHT 160
+
+#define TFT_CS   5
+#define TFT_DC  12
+#define TFT_RST 13
+
+#define LOAD_GLCD
+#define LOAD_GFXFF
+#define SMOOTH_FONT
+
+#define SPI_FREQUENCY 27000000
@@ -0,0 +1,88 @@
+// Minimal Arduino core for building TFT_eSPI on a host PC, see ../README.md
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string>
+#include <algorithm>
+
+#define ARDUINO 10800
+
+#define IRAM_ATTR
+#define PROGMEM
+#define HIGH 1
+#define LOW  0
+#define INPUT  0x01
+#define OUTPUT 0x02
+#define INPUT_PULLUP 0x05
+#define DEC 10
+#define HEX 16
+
+#define pgm_read_byte(a)  (*(const uint8_t*)(a))
+#define pgm_read_word(a)  (*(const uint16_t*)(a))
+#define pgm_read_dword(a) (*(const uint32_t*)(a))
+
+// As in the ESP32 core
+using std::min;
+using std::max;
+
+typedef bool    boolean;
+typedef uint8_t byte;
+
+void     pinMode(uint8_t pin, uint8_t mode);
+void     digitalWrite(uint8_t pin, uint8_t val);
+int      digitalRead(uint8_t pin);
+void     delay(uint32_t ms);
+void     delayMicroseconds(uint32_t us);
+void     yield(void);
+uint32_t millis(void);
+uint32_t micros(void);
+long     random(long howbig);
+long     random(long howsmall, long howbig);
+char*    ltoa(long val, char* s, int radix);
+char*    ultoa(unsigned long val, char* s, int radix);
+char*    dtostrf(double val, signed char width, unsigned char prec, char* s);
+bool     psramFound(void);
+void*    ps_malloc(size_t size);
+void*    ps_calloc(size_t n, size_t size);
+
+class String {
+ public:
+  String(const char* c = "") : s(c ? c : "") {}
+  String(const std::string& c) : s(c) {}
+  String(char c) : s(1, c) {}
+  String(int v) : s(std::to_string(v)) {}
+  String(long v) : s(std::to_string(v)) {}
+  String(unsigned v) : s(std::to_string(v)) {}
+  String(unsigned long v) : s(std::to_string(v)) {}
+
+  unsigned    length() const { return s.size(); }
+  const char* c_str()  const { return s.c_str(); }
+  char        charAt(unsigned i) const { return i < s.size() ? s[i] : 0; }
+  void        toCharArray(char* buf, unsigned n) const { if (n) { strncpy(buf, s.c_str(), n - 1); buf[n - 1] = 0; } }
+
+  bool    operator==(const char* c) const { return s == c; }
+  bool    operator==(const String& o) const { return s == o.s; }
+  String& operator+=(const String& o) { s += o.s; return *this; }
+  String  operator+(const String& o) const { return String(s + o.s); }
+  friend String operator+(const char* a, const String& b) { return String(std::string(a) + b.s); }
+
+ private:
+  std::string s;
+};
+
+#include "Print.h"
+
+class HardwareSerial : public Print {
+ public:
+  void   begin(unsigned long) {}
+  size_t write(uint8_t c) override { return fputc(c, stderr) == EOF ? 0 : 1; }
+};
+extern HardwareSerial Serial;
+
+#include "esp32-hal-gpio.h"
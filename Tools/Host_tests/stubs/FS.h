@@ -0,0 +1,55 @@
+// Arduino FS stub backed by host files, "/name" is opened in the directory set by
+// host_fs_root(). As on the ESP32 a File is a shared handle, close() closes all copies.
+#pragma once
+
+#include <Arduino.h>
+#include <memory>
+
+extern int host_files_open; // Number of files open now
+void host_file_access(void); // Called for each read and seek
+
+namespace fs {
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+class File {
+ public:
+  File() {}
+  explicit File(FILE* f) : _f(std::make_shared<Handle>(f)) {}
+
+  size_t read(uint8_t* buf, size_t n) { host_file_access(); return ok() ? fread(buf, 1, n, _f->f) : 0; }
+  int    read(void) { host_file_access(); int c = ok() ? fgetc(_f->f) : EOF; return c == EOF ? -1 : c; }
+  bool   seek(uint32_t pos, SeekMode mode = SeekSet) { host_file_access(); return ok() && fseek(_f->f, pos, mode) == 0; }
+  size_t position(void) const { return ok() ? ftell(_f->f) : 0; }
+  int    available(void) { return 0; }
+  void   close(void) { if (ok()) _f->close(); _f.reset(); }
+  operator bool() const { return ok(); }
+
+ private:
+  struct Handle {
+    FILE* f;
+    explicit Handle(FILE* file) : f(file) { if (f) host_files_open++; }
+    ~Handle() { close(); }
+    void close(void) { if (f) { fclose(f); f = nullptr; host_files_open--; } }
+  };
+
+  bool ok(void) const { return _f && _f->f; }
+
+  std::shared_ptr<Handle> _f;
+};
+
+class FS {
+ public:
+  virtual ~FS() {}
+  File open(const char* path, const char* mode = "r");
+  File open(const String& path, const char* mode = "r") { return open(path.c_str(), mode); }
+  bool exists(const char* path);
+  bool exists(const String& path) { return exists(path.c_str()); }
+};
+
+}
+
+using fs::File;
+using fs::FS;
+
+void host_fs_root(const char* dir); // Directory used for "/" by all FS objects
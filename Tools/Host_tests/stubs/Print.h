@@ -0,0 +1,30 @@
+// Minimal Arduino Print class, output is only needed for debug messages
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+
+class String;
+
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buf, size_t n) { size_t i = 0; while (n--) i += write(*buf++); return i; }
+  size_t write(const char* s) { return s ? write((const uint8_t*)s, strlen(s)) : 0; }
+
+  size_t print(const char* s) { return write(s); }
+  size_t print(const String& s);
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(long v, int base = 10) { char b[24]; snprintf(b, sizeof(b), base == 16 ? "%lx" : "%ld", v); return write(b); }
+  size_t print(int v, int base = 10) { return print((long)v, base); }
+  size_t print(unsigned long v, int base = 10) { char b[24]; snprintf(b, sizeof(b), base == 16 ? "%lx" : "%lu", v); return write(b); }
+  size_t print(unsigned v, int base = 10) { return print((unsigned long)v, base); }
+  size_t print(double v, int digits = 2) { char b[40]; snprintf(b, sizeof(b), "%.*f", digits, v); return write(b); }
+
+  template <typename T> size_t println(T v) { size_t n = print(v); return n + write((uint8_t)'\n'); }
+  template <typename T> size_t println(T v, int f) { size_t n = print(v, f); return n + write((uint8_t)'\n'); }
+  size_t println(void) { return write((uint8_t)'\n'); }
+};
@@ -0,0 +1,44 @@
+// SPI class stub, the library writes the ESP32 SPI registers directly, see soc/spi_reg.h
+#pragma once
+
+#include <Arduino.h>
+
+#define SPI_MODE0 0
+#define SPI_MODE1 1
+#define SPI_MODE2 2
+#define SPI_MODE3 3
+#define SPI_MSBFIRST 1
+#define MSBFIRST 1
+#define HSPI 2
+#define VSPI 3
+#define SPI_HAS_TRANSACTION
+
+struct SPISettings {
+  SPISettings(uint32_t = 0, uint8_t = 0, uint8_t = 0) {}
+};
+
+struct spi_struct_t;
+typedef struct spi_struct_t spi_t;
+
+class SPIClass {
+ public:
+  SPIClass(uint8_t bus = VSPI) : _bus(bus) {}
+  void     begin(int8_t = -1, int8_t = -1, int8_t = -1, int8_t = -1) {}
+  void     end(void) {}
+  void     beginTransaction(SPISettings) {}
+  void     endTransaction(void) {}
+  void     setFrequency(uint32_t) {}
+  void     setHwCs(bool) {}
+  uint8_t  transfer(uint8_t) { return 0; }
+  uint16_t transfer16(uint16_t) { return 0; }
+  uint32_t transfer32(uint32_t) { return 0; }
+  void     write32(uint32_t) {}
+  void     writeBytes(const uint8_t*, uint32_t) {}
+  void     writePixels(const void*, uint32_t) {}
+  spi_t*   bus(void) { return nullptr; }
+
+ private:
+  uint8_t _bus;
+};
+
+extern SPIClass SPI;
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <FS.h>
+
+class SPIFFSFS : public fs::FS {
+ public:
+  bool begin(bool = false) { return true; }
+};
+
+extern SPIFFSFS SPIFFS;
@@ -0,0 +1,7 @@
+// Peripheral clock and reset control, the host I2S model counts enables and disables
+#pragma once
+
+typedef enum { PERIPH_I2S0_MODULE = 6 } periph_module_t;
+
+void periph_module_enable(periph_module_t periph);
+void periph_module_disable(periph_module_t periph);
@@ -0,0 +1,72 @@
+// ESP-IDF SPI master driver API, the host version queues transactions in order and
+// completes them against a simulated bus clock, see host/host.h
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef int esp_err_t;
+#define ESP_OK          0
+#define ESP_FAIL       -1
+#define ESP_ERR_TIMEOUT 0x107
+#define ESP_ERROR_CHECK(x) do { esp_err_t err_ = (x); if (err_ != ESP_OK) abort(); } while (0)
+
+typedef uint32_t TickType_t;
+#define portMAX_DELAY (TickType_t)0xFFFFFFFF
+
+typedef enum { SPI1_HOST = 0, HSPI_HOST = 1, VSPI_HOST = 2 } spi_host_device_t;
+
+struct spi_transaction_t;
+typedef void (*transaction_cb_t)(struct spi_transaction_t *trans);
+
+#define SPI_TRANS_USE_TXDATA (1 << 3)
+#define SPI_DEVICE_NO_DUMMY  (1 << 6)
+
+typedef struct spi_transaction_t {
+  uint32_t flags;
+  uint16_t cmd;
+  uint64_t addr;
+  size_t   length;
+  size_t   rxlength;
+  void*    user;
+  union { const void* tx_buffer; uint8_t tx_data[4]; };
+  union { void* rx_buffer; uint8_t rx_data[4]; };
+} spi_transaction_t;
+
+typedef struct spi_device_t* spi_device_handle_t;
+
+typedef struct {
+  int mosi_io_num;
+  int miso_io_num;
+  int sclk_io_num;
+  int quadwp_io_num;
+  int quadhd_io_num;
+  int max_transfer_sz;
+  uint32_t flags;
+  int intr_flags;
+} spi_bus_config_t;
+
+typedef struct {
+  uint8_t  command_bits;
+  uint8_t  address_bits;
+  uint8_t  dummy_bits;
+  uint8_t  mode;
+  uint16_t duty_cycle_pos;
+  uint16_t cs_ena_pretrans;
+  uint8_t  cs_ena_posttrans;
+  int      clock_speed_hz;
+  int      input_delay_ns;
+  int      spics_io_num;
+  uint32_t flags;
+  int      queue_size;
+  transaction_cb_t pre_cb;
+  transaction_cb_t post_cb;
+} spi_device_interface_config_t;
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t* bus, int dma_chan);
+esp_err_t spi_bus_free(spi_host_device_t host);
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t* dev, spi_device_handle_t* handle);
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle);
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t* trans, TickType_t wait);
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t** trans, TickType_t wait);
@@ -0,0 +1,23 @@
+// ESP32 GPIO definitions used by the 8 bit parallel interface
+#pragma once
+
+#include <stdint.h>
+#include "soc/gpio_struct.h"
+#include "rom/gpio.h"
+
+typedef struct {
+  uint8_t reg;  // IO MUX register offset
+  int8_t  rtc;
+  int8_t  adc;
+  int8_t  touch;
+} esp32_gpioMux_t;
+
+extern const esp32_gpioMux_t esp32_gpioMux[40];
+
+extern uint32_t host_io_mux[64];
+
+#define ESP_REG(addr)      *((volatile uint32_t *)(addr))
+#define DR_REG_IO_MUX_BASE ((uintptr_t)host_io_mux)
+#define FUN_DRV_S 10
+#define FUN_IE    (1 << 9)
+#define MCU_SEL_S 12
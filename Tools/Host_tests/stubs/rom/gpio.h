@@ -0,0 +1,9 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+uint32_t gpio_input_get(void);
+
+// GPIO matrix, the host follows which pins are routed to I2S0
+void gpio_matrix_out(uint32_t gpio, uint32_t signal_idx, bool out_inv, bool oen_inv);
@@ -0,0 +1,6 @@
+// GPIO matrix output signals used to route the parallel bus to I2S0
+#pragma once
+
+#define I2S0O_WS_OUT_IDX     15
+#define I2S0O_DATA_OUT16_IDX 156
+#define SIG_GPIO_OUT_IDX     256
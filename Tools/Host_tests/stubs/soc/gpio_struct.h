@@ -0,0 +1,29 @@
+// GPIO registers, writes to the set and clear registers are passed to host_gpio_write()
+// so the host can follow the pin levels (DC, WR and the parallel data bus)
+#pragma once
+
+#include <stdint.h>
+
+void host_gpio_write(uint32_t set, uint32_t clr); // Pins 0-31
+
+struct host_gpio_w1ts {
+  void operator=(uint32_t v) volatile { host_gpio_write(v, 0); }
+};
+
+struct host_gpio_w1tc {
+  void operator=(uint32_t v) volatile { host_gpio_write(0, v); }
+};
+
+typedef struct {
+  host_gpio_w1ts out_w1ts;
+  host_gpio_w1tc out_w1tc;
+  struct { uint32_t val; } out1_w1ts;
+  struct { uint32_t val; } out1_w1tc;
+  uint32_t enable_w1ts;
+  uint32_t enable_w1tc;
+  uint32_t in;
+  struct { uint32_t val; } in1;
+  struct { uint32_t val; } pin[40];
+} gpio_dev_t;
+
+extern volatile gpio_dev_t GPIO;
@@ -0,0 +1,94 @@
+// I2S0 registers used by the 8 bit parallel DMA backend. Most fields are plain storage,
+// starting and stopping the transmitter, the raw interrupt and idle flags and the
+// interrupt clear register are passed to the host I2S model, see host/host.h
+#pragma once
+
+#include <stdint.h>
+
+#define I2S_OUT_TOTAL_EOF_INT_RAW (1 << 16)
+
+void     host_i2s_tx_start(uint32_t v);
+uint32_t host_i2s_int_raw(void);   // A read polls the peripheral, which takes 1us
+bool     host_i2s_tx_idle(void);
+void     host_i2s_int_clr(uint32_t v);
+
+struct host_i2s_tx_start_t {
+  void operator=(uint32_t v) volatile { host_i2s_tx_start(v); }
+};
+
+struct host_i2s_int_raw_t {
+  operator uint32_t() const volatile { return host_i2s_int_raw(); }
+};
+
+struct host_i2s_out_total_eof_t {
+  operator uint32_t() const volatile { return (host_i2s_int_raw() & I2S_OUT_TOTAL_EOF_INT_RAW) != 0; }
+};
+
+struct host_i2s_tx_idle_t {
+  operator uint32_t() const volatile { return host_i2s_tx_idle(); }
+};
+
+struct host_i2s_int_clr_t {
+  void operator=(uint32_t v) volatile { host_i2s_int_clr(v); }
+};
+
+typedef struct {
+  struct {
+    uint32_t val;
+    uint32_t tx_reset;
+    uint32_t tx_fifo_reset;
+    uint32_t tx_right_first;
+    host_i2s_tx_start_t tx_start;
+  } conf;
+  struct {
+    uint32_t val;
+    uint32_t out_rst;
+    uint32_t out_eof_mode;
+  } lc_conf;
+  struct {
+    host_i2s_int_raw_t val;
+    host_i2s_out_total_eof_t out_total_eof;
+  } int_raw;
+  struct { host_i2s_int_clr_t val; } int_clr;
+  struct { uint32_t val; } int_ena;
+  struct { host_i2s_tx_idle_t tx_idle; } state;
+  struct {
+    uint32_t addr;   // Low 20 bits of the first descriptor address
+    uint32_t start;
+  } out_link;
+  struct {
+    uint32_t val;
+    uint32_t lcd_en;
+  } conf2;
+  struct {
+    uint32_t val;
+    uint32_t tx_pcm_bypass;
+    uint32_t tx_stop_en;
+  } conf1;
+  struct {
+    uint32_t val;
+    uint32_t tx_chan_mod;
+  } conf_chan;
+  struct {
+    uint32_t val;
+    uint32_t tx_fifo_mod_force_en;
+    uint32_t tx_fifo_mod;
+    uint32_t tx_data_num;
+    uint32_t dscr_en;
+  } fifo_conf;
+  struct {
+    uint32_t val;
+    uint32_t tx_bits_mod;
+    uint32_t tx_bck_div_num;
+  } sample_rate_conf;
+  struct {
+    uint32_t val;
+    uint32_t clka_en;
+    uint32_t clkm_div_a;
+    uint32_t clkm_div_b;
+    uint32_t clkm_div_num;
+  } clkm_conf;
+  struct { uint32_t val; } timing;
+} i2s_dev_t;
+
+extern volatile i2s_dev_t I2S0;
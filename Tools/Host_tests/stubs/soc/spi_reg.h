@@ -0,0 +1,46 @@
+// ESP32 SPI registers, mapped to host memory. SPI_USR is 0 so a register transfer is
+// complete as soon as it is started. Register transfers are not decoded, only DMA
+// transactions reach the host panel on an SPI build (the parallel bus is decoded).
+#pragma once
+
+#include <stdint.h>
+
+extern uint32_t host_spi_regs[4][64];
+
+#define REG_SPI_BASE(i)        ((uintptr_t)host_spi_regs[(i) & 3])
+#define SPI_CMD_REG(i)         (REG_SPI_BASE(i) + 0x00)
+#define SPI_USER_REG(i)        (REG_SPI_BASE(i) + 0x1C)
+#define SPI_MOSI_DLEN_REG(i)   (REG_SPI_BASE(i) + 0x28)
+#define SPI_MISO_DLEN_REG(i)   (REG_SPI_BASE(i) + 0x2C)
+#define SPI_W0_REG(i)          (REG_SPI_BASE(i) + 0x80)
+#define SPI_W1_REG(i)          (REG_SPI_BASE(i) + 0x84)
+#define SPI_W2_REG(i)          (REG_SPI_BASE(i) + 0x88)
+#define SPI_W3_REG(i)          (REG_SPI_BASE(i) + 0x8C)
+#define SPI_W4_REG(i)          (REG_SPI_BASE(i) + 0x90)
+#define SPI_W5_REG(i)          (REG_SPI_BASE(i) + 0x94)
+#define SPI_W6_REG(i)          (REG_SPI_BASE(i) + 0x98)
+#define SPI_W7_REG(i)          (REG_SPI_BASE(i) + 0x9C)
+#define SPI_W8_REG(i)          (REG_SPI_BASE(i) + 0xA0)
+#define SPI_W9_REG(i)          (REG_SPI_BASE(i) + 0xA4)
+#define SPI_W10_REG(i)         (REG_SPI_BASE(i) + 0xA8)
+#define SPI_W11_REG(i)         (REG_SPI_BASE(i) + 0xAC)
+#define SPI_W12_REG(i)         (REG_SPI_BASE(i) + 0xB0)
+#define SPI_W13_REG(i)         (REG_SPI_BASE(i) + 0xB4)
+#define SPI_W14_REG(i)         (REG_SPI_BASE(i) + 0xB8)
+#define SPI_W15_REG(i)         (REG_SPI_BASE(i) + 0xBC)
+
+#define SPI_USR                0
+#define SPI_USR_MOSI           (1u << 27)
+#define SPI_USR_MISO           (1u << 28)
+#define SPI_DOUTDIN            (1u << 0)
+#define SPI_CK_OUT_EDGE        (1u << 7)
+#define SPI_USR_MOSI_DBITLEN   0x00FFFFFF
+#define SPI_USR_MOSI_DBITLEN_S 0
+#define SPI_USR_MISO_DBITLEN   0x00FFFFFF
+#define SPI_USR_MISO_DBITLEN_S 0
+
+#define WRITE_PERI_REG(a, v)   (*(volatile uint32_t*)(a) = (v))
+#define READ_PERI_REG(a)       (*(volatile uint32_t*)(a))
+#define SET_PERI_REG_MASK(a, m)   (*(volatile uint32_t*)(a) |= (m))
+#define CLEAR_PERI_REG_MASK(a, m) (*(volatile uint32_t*)(a) &= ~(m))
+#define SET_PERI_REG_BITS(a, b, v, s) (*(volatile uint32_t*)(a) = (*(volatile uint32_t*)(a) & ~((b) << (s))) | (((v) & (b)) << (s)))
@@ -0,0 +1,297 @@
+// 8 bit parallel DMA through I2S0: images and pixels sent by DMA must match the same pixels
+// sent by the CPU, transfers are split and fenced, and CPU drawing after a transfer must
+// wait for it and get the bus pins back from the I2S peripheral
+#include <functional>
+#include <TFT_eSPI.h>
+#include "host.h"
+
+extern uint32_t dmaFenceQueued;
+
+static TFT_eSPI tft;
+static TFT_eSprite spr(&tft);
+
+static uint16_t expect[HOST_PANEL_SIZE][HOST_PANEL_SIZE];
+
+static std::vector<uint32_t> doneFence;
+static void done(uint32_t fence, void*) { doneFence.push_back(fence); }
+
+static std::vector<uint16_t> randomImage(int32_t w, int32_t h)
+{
+  std::vector<uint16_t> img(w * h);
+  for (auto& c : img) c = random(0x10000);
+  return img;
+}
+
+static void keepExpected(void) { memcpy(expect, host_panel, sizeof(expect)); }
+static bool matchesExpected(void) { return memcmp(expect, host_panel, sizeof(expect)) == 0; }
+
+// pushImageDMA() with and without a buffer and byte swapping, compared with pushImage()
+static void compareImage(int32_t x, int32_t y, int32_t w, int32_t h)
+{
+  std::vector<uint16_t> img = randomImage(w, h);
+
+  for (int mode = 0; mode < 4; mode++)
+  {
+    bool swap = mode & 1, buffered = mode & 2;
+
+    host_panel_clear(TFT_MAGENTA);
+    tft.setSwapBytes(swap);
+    tft.pushImage(x, y, w, h, img.data());
+    keepExpected();
+    uint32_t pixels = host_bus.pixels;
+
+    std::vector<uint16_t> copy = img;
+    std::vector<uint16_t> buffer(w * h);
+    host_panel_clear(TFT_MAGENTA);
+    host_dma_reset();
+    doneFence.clear();
+    tft.startWrite();
+    uint32_t fence = tft.pushImageDMA(x, y, w, h, copy.data(), buffered ? buffer.data() : nullptr, done);
+    tft.dmaWait();
+    tft.endWrite();
+
+    HOST_CHECK(matchesExpected());
+    HOST_CHECK(host_bus.pixels == pixels);
+    HOST_CHECK(tft.dmaFenceDone(fence));
+    HOST_CHECK(doneFence.size() == (pixels ? 1u : 0u));
+    HOST_CHECK(host_dma.queued == (pixels ? 1u : 0u));
+    if (buffered) HOST_CHECK(copy == img); // The image is only changed without a buffer
+  }
+  tft.setSwapBytes(false);
+}
+
+// Pushes longer than DMA_I2S_MAX_LEN bytes are sent as several transfers, with the callback
+// on the last one
+static void longPush(void)
+{
+  const uint32_t len = DMA_I2S_MAX_LEN / 2 * 5 / 2;
+  std::vector<uint16_t> img = randomImage(len, 1);
+
+  host_panel_clear(TFT_MAGENTA);
+  tft.setSwapBytes(true);
+  tft.startWrite();
+  tft.setAddrWindow(0, 0, tft.width(), tft.height());
+  tft.pushPixels(img.data(), len);
+  tft.endWrite();
+  keepExpected();
+
+  host_panel_clear(TFT_MAGENTA);
+  host_dma_reset();
+  doneFence.clear();
+  uint32_t first = tft.dmaFence() + 1;
+  tft.startWrite();
+  tft.setAddrWindow(0, 0, tft.width(), tft.height());
+  uint32_t fence = tft.pushPixelsDMA(img.data(), len, done);
+  tft.dmaWait();
+  tft.endWrite();
+  tft.setSwapBytes(false);
+
+  HOST_CHECK(matchesExpected());
+  HOST_CHECK(host_bus.pixels == len);
+  HOST_CHECK(host_dma.queued == 3);
+  HOST_CHECK(fence == first + 2);
+  HOST_CHECK(doneFence.size() == 1 && doneFence[0] == fence);
+  HOST_CHECK(host_dma.busy_ns == (uint64_t)len * 2 * 25 * TFT_I2S_CLK_DIV);
+}
+
+// Without setSwapBytes(true) the image is swapped in place, so the same line pushed twice
+// is sent once in each byte order and must not be changed while the first is being sent
+static void inPlace(void)
+{
+  std::vector<uint16_t> img = randomImage(50, 1);
+
+  host_panel_clear(TFT_MAGENTA);
+  tft.startWrite();
+  tft.setAddrWindow(0, 0, 100, 1);
+  tft.pushPixels(img.data(), 50);
+  tft.setSwapBytes(true);
+  tft.pushPixels(img.data(), 50);
+  tft.setSwapBytes(false);
+  tft.endWrite();
+  keepExpected();
+
+  host_panel_clear(TFT_MAGENTA);
+  tft.startWrite();
+  tft.setAddrWindow(0, 0, 100, 1);
+  tft.pushPixelsDMA(img.data(), 50);
+  tft.pushPixelsDMA(img.data(), 50);
+  tft.endWrite();
+  HOST_CHECK(matchesExpected());
+}
+
+// A transfer runs while the CPU works, the fence is done once the transfer is retired and
+// drawing by the CPU waits for it before the pins are used
+static void overlap(void)
+{
+  std::vector<uint16_t> img = randomImage(60, 40);
+
+  host_panel_clear(TFT_MAGENTA);
+  tft.setSwapBytes(true);
+  tft.pushImage(10, 20, 60, 40, img.data());
+  tft.fillRect(30, 30, 50, 10, TFT_GREEN);
+  tft.drawPixel(5, 5, TFT_RED);
+  keepExpected();
+
+  host_panel_clear(TFT_MAGENTA);
+  host_dma_reset();
+  tft.startWrite();
+  uint32_t fence = tft.pushImageDMA(10, 20, 60, 40, img.data());
+  HOST_CHECK(tft.dmaBusy());
+  host_cpu(1000);
+  HOST_CHECK(!tft.dmaFenceDone(fence));
+  host_cpu(60 * 40 * 2 * 25 * TFT_I2S_CLK_DIV);
+  HOST_CHECK(!tft.dmaFenceDone(fence)); // Sent, but only retired by dmaBusy() or dmaWait()
+  HOST_CHECK(!tft.dmaBusy());
+  HOST_CHECK(tft.dmaFenceDone(fence));
+
+  host_panel_clear(TFT_MAGENTA);
+  uint64_t start = host_time_ns;
+  fence = tft.pushImageDMA(10, 20, 60, 40, img.data());
+  tft.fillRect(30, 30, 50, 10, TFT_GREEN); // Waits for the transfer
+  HOST_CHECK(tft.dmaFenceDone(fence));
+  HOST_CHECK(host_time_ns - start >= 60 * 40 * 2 * 25 * TFT_I2S_CLK_DIV);
+  tft.drawPixel(5, 5, TFT_RED);
+  fence = tft.pushImageDMA(10, 20, 60, 40, img.data());
+  tft.endWrite(); // Waits for the transfer
+  tft.setSwapBytes(false);
+
+  HOST_CHECK(tft.dmaFenceDone(fence));
+  tft.fillRect(30, 30, 50, 10, TFT_GREEN);
+  HOST_CHECK(matchesExpected());
+}
+
+// Every CPU drawing path must wait for a transfer before it drives the bus, the host model
+// aborts the test if WR is written while it is routed to the I2S peripheral
+static void cpuAfterDma(void)
+{
+  static uint16_t line[20];
+  for (int i = 0; i < 20; i++) line[i] = 0x1111 * i;
+
+  const std::vector<std::function<void(void)>> draw = {
+    [] { tft.drawPixel(15, 25, TFT_RED); },
+    [] { tft.drawFastHLine(0, 30, 100, TFT_RED); },
+    [] { tft.drawFastVLine(30, 0, 100, TFT_RED); },
+    [] { tft.drawLine(0, 0, 90, 70, TFT_RED); },
+    [] { tft.fillRect(20, 25, 30, 5, TFT_RED); },
+    [] { tft.fillScreen(TFT_RED); },
+    [] { tft.drawString("Text", 12, 22, 1); },
+    [] { tft.drawChar('A', 12, 22, 2); },
+    [] { tft.setAddrWindow(12, 22, 20, 1); tft.pushPixels(line, 20); },
+    [] { tft.setAddrWindow(12, 22, 20, 1); tft.pushColor(TFT_RED, 20); },
+    [] { tft.pushImage(14, 24, 20, 1, line); },
+    [] { tft.writecommand(0x2C); tft.writedata(0); tft.writedata(0); },
+  };
+
+  std::vector<uint16_t> img = randomImage(60, 40);
+  tft.setTextColor(TFT_WHITE, TFT_BLACK);
+
+  for (auto& f : draw)
+  {
+    host_panel_clear(TFT_MAGENTA);
+    tft.setSwapBytes(true);
+    tft.pushImage(10, 20, 60, 40, img.data());
+    f();
+    keepExpected();
+
+    host_panel_clear(TFT_MAGENTA);
+    tft.startWrite();
+    tft.pushImageDMA(10, 20, 60, 40, img.data());
+    f();
+    tft.endWrite();
+    tft.setSwapBytes(false);
+    HOST_CHECK(matchesExpected());
+  }
+}
+
+// pushBandsDMA() renders each band while the previous one is sent
+static uint16_t bandColor(int32_t x, int32_t y) { return (x * 7 + y * 13) * 97; }
+
+static void fillBand(uint16_t* buf, int32_t x, int32_t y, int32_t w, int32_t n)
+{
+  for (int32_t j = 0; j < n; j++)
+    for (int32_t i = 0; i < w; i++) buf[j * w + i] = bandColor(x + i, y + j);
+  host_cpu(w * n * 20); // Rendering is a little faster than sending
+}
+
+static void bands(void)
+{
+  const int32_t x = -5, y = 12, w = 90, h = 100;
+
+  host_panel_clear(TFT_MAGENTA);
+  tft.setSwapBytes(true);
+  for (int32_t j = 0; j < h; j++)
+    for (int32_t i = 0; i < w; i++) tft.drawPixel(x + i, y + j, bandColor(x + i, y + j));
+  keepExpected();
+
+  host_panel_clear(TFT_MAGENTA);
+  host_dma_reset();
+  int64_t heap = host_heap_used;
+  tft.startWrite();
+  HOST_CHECK(tft.pushBandsDMA(x, y, w, h, 16, fillBand));
+  tft.endWrite();
+  tft.setSwapBytes(false);
+
+  HOST_CHECK(matchesExpected());
+  HOST_CHECK(host_dma.queued == (h + 15) / 16);
+  HOST_CHECK(host_heap_used == heap);
+}
+
+// 8 bit parallel displays push sprites with the CPU
+static void sprite(void)
+{
+  spr.setColorDepth(16);
+  spr.createSprite(40, 30);
+  spr.fillSprite(TFT_NAVY);
+  spr.fillRect(2, 2, 15, 10, TFT_ORANGE);
+  spr.drawString("DMA", 4, 15, 1);
+
+  host_panel_clear(TFT_MAGENTA);
+  spr.pushSprite(-10, 50);
+  keepExpected();
+
+  host_panel_clear(TFT_MAGENTA);
+  host_dma_reset();
+  uint32_t fence = spr.pushSpriteDMA(-10, 50);
+  HOST_CHECK(matchesExpected());
+  HOST_CHECK(tft.dmaFenceDone(fence));
+  HOST_CHECK(host_dma.queued == 0);
+  spr.deleteSprite();
+}
+
+int main()
+{
+  tft.init();
+  int64_t heap = host_heap_used;
+  HOST_CHECK(tft.initDMA());
+  HOST_CHECK(host_i2s_enabled == 1);
+
+  const int32_t W = tft.width(), H = tft.height();
+  compareImage(10, 20, 50, 40);
+  compareImage(-7, 3, 30, 20);       // Clipped left
+  compareImage(W - 12, H - 9, 30, 20); // Clipped right and bottom
+  compareImage(0, 0, W, H);          // Full screen, several descriptors
+  compareImage(W, 0, 10, 10);        // Not visible
+
+  tft.setViewport(20, 30, 60, 50, false); // DMA pushes do not move the datum
+  compareImage(15, 25, 30, 30);
+  tft.resetViewport();
+
+  longPush();
+  inPlace();
+  overlap();
+  cpuAfterDma();
+  bands();
+  sprite();
+
+  tft.deInitDMA();
+  HOST_CHECK(host_i2s_enabled == 0);
+  HOST_CHECK(host_heap_used == heap);
+
+  // Drawing with the CPU still works once DMA is released
+  const uint16_t red = TFT_RED;
+  host_panel_clear(TFT_MAGENTA);
+  tft.fillRect(0, 0, 4, 4, red);
+  HOST_CHECK(host_panel[3][3] == red);
+
+  return host_result("i2s_dma");
+}
@@ -0,0 +1,152 @@
+// drawLine() finds each Bresenham run directly and sends it as one window. It is compared
+// with the pixel by pixel loop it replaced (below, as in the original library) for
+// identical pixels, bytes sent and host time
+#include <TFT_eSPI.h>
+#include "host.h"
+
+class LineTFT : public TFT_eSPI {
+ public:
+  // drawLine() before the runs were stepped directly
+  void oldDrawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color)
+  {
+    if (_vpOoB) return;
+    startWrite();
+
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep) {
+      swap_coord(x0, y0);
+      swap_coord(x1, y1);
+    }
+
+    if (x0 > x1) {
+      swap_coord(x0, x1);
+      swap_coord(y0, y1);
+    }
+
+    int32_t dx = x1 - x0, dy = abs(y1 - y0);
+    int32_t err = dx >> 1, ystep = -1, xs = x0, dlen = 0;
+    if (y0 < y1) ystep = 1;
+
+    if (steep) {
+      for (; x0 <= x1; x0++) {
+        dlen++;
+        err -= dy;
+        if (err < 0) {
+          if (dlen == 1) drawPixel(y0, xs, color);
+          else drawFastVLine(y0, xs, dlen, color);
+          dlen = 0;
+          y0 += ystep;
+          xs = x0 + 1;
+          err += dx;
+        }
+      }
+      if (dlen) drawFastVLine(y0, xs, dlen, color);
+    } else {
+      for (; x0 <= x1; x0++) {
+        dlen++;
+        err -= dy;
+        if (err < 0) {
+          if (dlen == 1) drawPixel(xs, y0, color);
+          else drawFastHLine(xs, y0, dlen, color);
+          dlen = 0;
+          y0 += ystep;
+          xs = x0 + 1;
+          err += dx;
+        }
+      }
+      if (dlen) drawFastHLine(xs, y0, dlen, color);
+    }
+
+    endWrite();
+  }
+};
+
+static LineTFT tft;
+static uint16_t expect[HOST_PANEL_SIZE][HOST_PANEL_SIZE];
+
+struct line { int32_t x0, y0, x1, y1; uint32_t color; };
+
+static uint32_t busBytes(void)
+{
+  return host_bus.commands + host_bus.data + host_bus.pixels * 2;
+}
+
+struct cost { uint32_t commands, bytes; uint64_t us; };
+
+// Draw the lines with each method, check the pixels match and add up bytes and host time
+static void compare(const std::vector<line>& lines, cost& oldCost, cost& newCost)
+{
+  host_panel_clear(TFT_BLACK);
+  uint64_t t = host_micros();
+  for (const line& l : lines) tft.oldDrawLine(l.x0, l.y0, l.x1, l.y1, l.color);
+  oldCost.us += host_micros() - t;
+  oldCost.commands += host_bus.commands;
+  oldCost.bytes += busBytes();
+  memcpy(expect, host_panel, sizeof(expect));
+
+  uint32_t oldBytes = busBytes();
+  host_panel_clear(TFT_BLACK);
+  t = host_micros();
+  for (const line& l : lines) tft.drawLine(l.x0, l.y0, l.x1, l.y1, l.color);
+  newCost.us += host_micros() - t;
+  newCost.commands += host_bus.commands;
+  newCost.bytes += busBytes();
+
+  HOST_CHECK(memcmp(expect, host_panel, sizeof(expect)) == 0);
+  HOST_CHECK(busBytes() <= oldBytes);
+}
+
+static void print(const char* name, const cost& o, const cost& n)
+{
+  printf("%-18s %8u %8u %10u %10u %8llu %8llu\n", name, o.commands, n.commands, o.bytes, n.bytes,
+         (unsigned long long)o.us, (unsigned long long)n.us);
+}
+
+static int32_t rnd(int32_t lo, int32_t hi) { return lo + random(hi - lo + 1); }
+
+int main()
+{
+  srand(5);
+  tft.init();
+  tft.setRotation(1);
+
+  printf("                   commands          bus bytes         host us\n");
+  printf("lines               old      new       old        new      old      new\n");
+
+  // Oscilloscope trace of 160 short segments, drawn 20 times
+  std::vector<line> trace;
+  int32_t py = 64;
+  for (int r = 0; r < 20; r++)
+    for (int32_t x = 0; x < 160; x++)
+    {
+      int32_t y = 64 + 50 * sinf(x * 0.15f) + rnd(-8, 8);
+      trace.push_back({ x, py, x + 1, y, TFT_GREEN });
+      py = y;
+    }
+  cost o = {}, n = {};
+  compare(trace, o, n);
+  print("trace", o, n);
+
+  // Random lines on and around the screen, in random viewports
+  o = n = {};
+  for (int v = 0; v < 20; v++)
+  {
+    tft.setViewport(rnd(-10, 80), rnd(-10, 60), rnd(1, 170), rnd(1, 140), v & 1);
+    std::vector<line> lines;
+    for (int i = 0; i < 200; i++)
+      lines.push_back({ rnd(-40, 200), rnd(-40, 170), rnd(-40, 200), rnd(-40, 170), (uint32_t)random(0x10000) });
+    compare(lines, o, n);
+  }
+  tft.resetViewport();
+  print("random, viewports", o, n);
+
+  // Long lines that are mostly off the screen
+  std::vector<line> lines;
+  for (int i = 0; i < 200; i++)
+    lines.push_back({ rnd(-20000, 20000), rnd(-20000, 20000), rnd(0, 159), rnd(0, 127), TFT_WHITE });
+  o = n = {};
+  compare(lines, o, n);
+  print("long, mostly off", o, n);
+
+  return host_result("par_bench_lines");
+}
@@ -0,0 +1,142 @@
+// A frame recorded in the display list draws the same pixels as drawing it directly, with
+// viewports, images drawn between recorded items, rotation changes and lists too small
+// for the frame. Nothing is sent while recording. The bytes sent each way are printed.
+#include <TFT_eSPI.h>
+#include "host.h"
+
+static TFT_eSPI tft;
+static uint16_t expect[HOST_PANEL_SIZE][HOST_PANEL_SIZE];
+
+static uint32_t busBytes(void)
+{
+  return host_bus.commands + host_bus.data + host_bus.pixels * 2;
+}
+
+static int32_t rnd(int32_t lo, int32_t hi) { return lo + random(hi - lo + 1); }
+
+// A dashboard: panels, bars, gauge lines and text over a background
+static void dashboard(void)
+{
+  tft.fillScreen(TFT_NAVY);
+  for (int p = 0; p < 4; p++)
+  {
+    int32_t x = (p & 1) * 64, y = (p >> 1) * 80;
+    tft.fillRect(x + 2, y + 2, 60, 76, TFT_DARKGREY);
+    tft.drawRect(x + 2, y + 2, 60, 76, TFT_WHITE);
+    tft.setTextColor(TFT_YELLOW, TFT_DARKGREY);
+    tft.drawString("Panel", x + 6, y + 6, 1);
+    for (int b = 0; b < 6; b++)
+    {
+      int32_t h = 10 + (p * 7 + b * 13) % 40;
+      tft.fillRect(x + 6 + b * 9, y + 70 - h, 7, h, TFT_GREEN);
+      tft.drawFastHLine(x + 6 + b * 9, y + 70 - h, 7, TFT_WHITE);
+    }
+    tft.fillCircle(x + 50, y + 20, 8, TFT_RED);
+    tft.drawLine(x + 50, y + 20, x + 50 + 7 * (p - 1), y + 14, TFT_WHITE);
+  }
+  for (int i = 0; i < 40; i++) tft.drawPixel(4 + i * 3, 158, TFT_WHITE);
+}
+
+// Random primitives, sometimes in a viewport, with images and rotation changes between them
+static void randomFrame(uint32_t seed, bool bypass)
+{
+  srand(seed);
+  static uint16_t image[20 * 15];
+  for (int i = 0; i < 20 * 15; i++) image[i] = i * 97;
+
+  tft.fillScreen(TFT_BLACK);
+  for (int i = 0; i < 300; i++)
+  {
+    uint32_t c = random(0x10000);
+    switch (random(8))
+    {
+      case 0: tft.fillRect(rnd(-20, 170), rnd(-20, 170), rnd(-5, 60), rnd(-5, 60), c); break;
+      case 1: tft.drawFastHLine(rnd(-20, 170), rnd(-20, 170), rnd(-5, 100), c); break;
+      case 2: tft.drawFastVLine(rnd(-20, 170), rnd(-20, 170), rnd(-5, 100), c); break;
+      case 3: tft.drawPixel(rnd(-5, 165), rnd(-5, 165), c); break;
+      case 4: tft.drawLine(rnd(-40, 200), rnd(-40, 200), rnd(-40, 200), rnd(-40, 200), c); break;
+      case 5: tft.fillCircle(rnd(-10, 170), rnd(-10, 170), rnd(0, 25), c); break;
+      case 6:
+        tft.setTextColor(c, ~c & 0xFFFF);
+        tft.drawString("List", rnd(-10, 150), rnd(-10, 150), 1);
+        break;
+      case 7:
+        if (!random(4)) tft.setViewport(rnd(0, 60), rnd(0, 60), rnd(10, 120), rnd(10, 120), random(2));
+        else tft.resetViewport();
+        break;
+    }
+
+    if (bypass && !random(40)) tft.pushImage(rnd(-10, 150), rnd(-10, 150), 20, 15, image);
+    if (bypass && !random(100)) tft.setRotation(random(4));
+  }
+  tft.resetViewport();
+}
+
+// Draw a frame directly, then recorded, check the pixels match and return the bytes each way
+static void compare(void (*frame)(uint32_t, bool), uint32_t seed, bool bypass,
+                    uint16_t items, uint16_t bandRows, uint32_t* direct, uint32_t* recorded)
+{
+  tft.setRotation(0);
+  host_panel_clear(TFT_BLACK);
+  frame(seed, bypass);
+  *direct = busBytes();
+  memcpy(expect, host_panel, sizeof(expect));
+
+  tft.setRotation(0);
+  host_panel_clear(TFT_BLACK);
+  HOST_CHECK(tft.setDisplayList(items, bandRows));
+  HOST_CHECK(tft.startRecording());
+  frame(seed, bypass);
+  if (!bypass && items > 2000) HOST_CHECK(busBytes() == 0); // Nothing sent yet
+  tft.endRecording();
+  *recorded = busBytes();
+  HOST_CHECK(tft.setDisplayList(0));
+
+  HOST_CHECK(memcmp(expect, host_panel, sizeof(expect)) == 0);
+}
+
+static void dashboardFrame(uint32_t, bool) { dashboard(); }
+
+int main()
+{
+  tft.init();
+  int64_t heap = host_heap_used;
+  uint32_t direct, recorded;
+
+  printf("frame                      direct bytes  recorded bytes\n");
+
+  compare(dashboardFrame, 0, false, 4000, 16, &direct, &recorded);
+  HOST_CHECK(recorded < direct);
+  printf("%-26s %12u %15u\n", "dashboard", direct, recorded);
+
+  compare(dashboardFrame, 0, false, 4000, 1, &direct, &recorded);
+  printf("%-26s %12u %15u\n", "dashboard, 1 row bands", direct, recorded);
+
+  compare(dashboardFrame, 0, false, 20, 16, &direct, &recorded);
+  printf("%-26s %12u %15u\n", "dashboard, 20 item list", direct, recorded);
+
+  uint32_t d = 0, r = 0;
+  for (uint32_t seed = 1; seed <= 30; seed++)
+  {
+    compare(randomFrame, seed, false, 60000, 1 + seed % 24, &direct, &recorded);
+    d += direct; r += recorded;
+  }
+  printf("%-26s %12u %15u\n", "30 random", d, r);
+
+  d = r = 0;
+  for (uint32_t seed = 1; seed <= 30; seed++)
+  {
+    compare(randomFrame, seed, true, 4000, 16, &direct, &recorded);
+    d += direct; r += recorded;
+  }
+  printf("%-26s %12u %15u\n", "30 random, images, rotation", d, r);
+
+  // Lists that fill part way through the frame
+  for (uint32_t seed = 1; seed <= 10; seed++) compare(randomFrame, seed, true, rnd(1, 64), 8, &direct, &recorded);
+
+  // Recording without a list does nothing
+  HOST_CHECK(!tft.startRecording());
+  HOST_CHECK(host_heap_used == heap);
+
+  return host_result("par_display_list");
+}
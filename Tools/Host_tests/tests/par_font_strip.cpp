@@ -0,0 +1,114 @@
+// drawStringStrip() with a font file: glyphs are read before the TFT is selected, strings
+// whose glyphs do not all fit in the cache, or cannot be read, are drawn glyph by glyph
+#include <TFT_eSPI.h>
+#include "host.h"
+
+// Counts how strings with a background are drawn
+class StripTFT : public TFT_eSPI {
+ public:
+  int strips = 0, glyphs = 0;
+
+ protected:
+  bool drawStringStrip(const char *string, int32_t poX, int32_t poY, int32_t cwidth, int32_t x0, int32_t x1)
+  {
+    bool ok = TFT_eSPI::drawStringStrip(string, poX, poY, cwidth, x0, x1);
+    if (ok) strips++;
+    else glyphs++;
+    return ok;
+  }
+};
+
+static StripTFT tft;
+
+static const uint32_t glyphBytes = 8 * 10;
+static const uint32_t entryBytes = 16 + glyphBytes; // Cache entry header and bitmap
+
+static void put32(FILE* f, uint32_t x)
+{
+  for (int s = 24; s >= 0; s -= 8) fputc(x >> s, f);
+}
+
+// A vlw font of 8x10 glyphs for codes 0x21 to 0x7E, each with a different bitmap.
+// If "bitmaps" is less than 94 the file ends part way through the bitmaps.
+static void writeFont(const char* name, uint32_t bitmaps)
+{
+  FILE* f = fopen(name, "wb");
+  put32(f, 94); put32(f, 11); put32(f, 12); put32(f, 0); put32(f, 9); put32(f, 3);
+  for (uint32_t c = 0x21; c < 0x7F; c++)
+  {
+    put32(f, c); put32(f, 10); put32(f, 8); put32(f, 9); put32(f, 9); put32(f, 0); put32(f, 0);
+  }
+  for (uint32_t i = 0; i < bitmaps * glyphBytes; i++)
+  {
+    uint32_t c = i / glyphBytes, p = i % glyphBytes;
+    fputc(((p * 37 + c * 11) & 0xFF) | ((p % 9 == c % 9) ? 0xFF : 0), f);
+  }
+  fclose(f);
+}
+
+// Draw a string glyph by glyph as the reference, then with the given cache size
+static void compare(const char* text, uint32_t cacheBytes, bool strip)
+{
+  static uint16_t expect[HOST_PANEL_SIZE][HOST_PANEL_SIZE];
+
+  tft.setGlyphCacheSize(0);
+  host_panel_clear(TFT_BLUE);
+  tft.drawString(text, 2, 30);
+  memcpy(expect, host_panel, sizeof(expect));
+
+  tft.setGlyphCacheSize(cacheBytes);
+  tft.strips = tft.glyphs = 0;
+  host_file_reads_selected = 0;
+  host_panel_clear(TFT_BLUE);
+  tft.drawString(text, 2, 30);
+
+  HOST_CHECK(memcmp(expect, host_panel, sizeof(expect)) == 0);
+  HOST_CHECK(tft.strips == (strip ? 1 : 0));
+  HOST_CHECK(tft.glyphs == (strip ? 0 : 1));
+  if (strip) HOST_CHECK(host_file_reads_selected == 0);
+}
+
+int main()
+{
+  host_fs_root(".");
+  writeFont("strip.vlw", 94);
+  writeFont("strip_short.vlw", 20);
+
+  tft.init();
+  tft.setTextColor(TFT_YELLOW, TFT_DARKGREEN);
+  tft.setTextPadding(120);
+  tft.loadFont("strip", SPIFFS);
+
+  const char* text = "Band,Text:AAxy"; // 12 different glyphs, several bands
+  uint32_t need = 12 * entryBytes;
+
+  // All the glyphs fit, each is read from the file once, before the TFT is selected
+  compare(text, need, true);
+  uint32_t hits, misses;
+  tft.setGlyphCacheSize(need);
+  tft.getGlyphCacheStats(nullptr, nullptr, true);
+  tft.drawString(text, 2, 30);
+  tft.getGlyphCacheStats(&hits, &misses);
+  HOST_CHECK(misses == 0);
+
+  // Glyphs cached before the string are evicted to make room, the string still fits
+  tft.setGlyphCacheSize(need);
+  tft.drawString("0123456789", 2, 60);
+  compare(text, need, true);
+
+  // The string needs one glyph more than the cache holds
+  compare(text, need - 1, false);
+  compare(text, 3 * entryBytes, false);
+
+  // A bitmap that cannot be read is not drawn as background
+  tft.unloadFont();
+  tft.loadFont("strip_short", SPIFFS);
+  compare("!\"#$%", 5 * entryBytes, true);  // Glyphs 0 to 4 are in the file
+  tft.strips = tft.glyphs = 0;
+  tft.setGlyphCacheSize(20 * entryBytes);
+  tft.drawString("Missing", 2, 30);         // Glyphs past the end of the file
+  HOST_CHECK(tft.strips == 0 && tft.glyphs == 1);
+
+  tft.unloadFont();
+  return host_result("par_font_strip");
+}
@@ -0,0 +1,73 @@
+// GLCD strings with a background: a string wider than the screen is drawn character by
+// character, and the strip buffers must not be sized from its length first. The strings
+// are drawn on a thread with a painted stack so the stack used can be measured.
+#include <pthread.h>
+#include <TFT_eSPI.h>
+#include "host.h"
+
+static TFT_eSPI tft;
+
+static std::string text;
+
+static void* drawText(void*)
+{
+  tft.setTextColor(TFT_YELLOW, TFT_BLUE);
+  tft.drawString(text.c_str(), 0, 10, 1);
+  return nullptr;
+}
+
+// Run drawText() on a painted stack and return the number of bytes it used
+static size_t drawOnThread(void)
+{
+  const size_t size = 256 * 1024;
+  static uint8_t stack[size] __attribute__((aligned(4096)));
+  memset(stack, 0xA5, size);
+
+  pthread_attr_t attr;
+  pthread_t thread;
+  pthread_attr_init(&attr);
+  pthread_attr_setstack(&attr, stack, size);
+  HOST_CHECK(pthread_create(&thread, &attr, drawText, nullptr) == 0);
+  pthread_join(thread, nullptr);
+  pthread_attr_destroy(&attr);
+
+  size_t unused = 0;
+  while (unused < size && stack[unused] == 0xA5) unused++;
+  return size - unused;
+}
+
+int main()
+{
+  tft.init();
+  tft.setRotation(0);
+  tft.setTextSize(1);
+
+  // Stack used drawing a short string, which is drawn as a strip
+  text = "ABC";
+  const size_t stackLimit = drawOnThread() + 8 * 1024;
+
+  // The visible characters match ones drawn one at a time
+  const int32_t chars = tft.width() / 6 + 1;
+  static uint16_t expect[HOST_PANEL_SIZE][HOST_PANEL_SIZE];
+  host_panel_clear(TFT_MAGENTA);
+  tft.setTextColor(TFT_YELLOW, TFT_BLUE);
+  for (int32_t i = 0; i < chars; i++) tft.drawChar('A' + i % 26, 6 * i, 10, 1);
+  memcpy(expect, host_panel, sizeof(expect));
+
+  for (uint32_t len : { 40u, 1000u, 10000u })
+  {
+    text.clear();
+    for (uint32_t i = 0; i < len; i++) text += (char)('A' + i % 26);
+
+    host_panel_clear(TFT_MAGENTA);
+    HOST_CHECK(drawOnThread() < stackLimit);
+    HOST_CHECK(memcmp(expect, host_panel, sizeof(expect)) == 0);
+  }
+
+  // The 16 bit string width wraps round to 8 pixels, so the strip fits the screen but the
+  // text does not. The character codes were read onto the stack before this was found.
+  text.assign(109228, 'A');
+  HOST_CHECK(drawOnThread() < stackLimit);
+
+  return host_result("par_glcd_strip");
+}
@@ -0,0 +1,60 @@
+// fillPolygon() with more than POLYGON_STACK_CORNERS corners keeps its tables in the heap:
+// the same outline with each corner repeated draws the same pixels and frees the memory
+#include <TFT_eSPI.h>
+#include "host.h"
+
+static TFT_eSPI tft;
+static uint16_t expect[HOST_PANEL_SIZE][HOST_PANEL_SIZE];
+
+// Draw a polygon, then the same outline with every corner given "repeat" times
+static void compare(const std::vector<int32_t>& x, const std::vector<int32_t>& y, uint16_t repeat)
+{
+  host_panel_clear(TFT_BLACK);
+  tft.fillPolygon(x.data(), y.data(), x.size(), TFT_GREEN);
+  memcpy(expect, host_panel, sizeof(expect));
+
+  std::vector<int32_t> rx, ry;
+  for (size_t i = 0; i < x.size(); i++)
+    for (uint16_t r = 0; r < repeat; r++) { rx.push_back(x[i]); ry.push_back(y[i]); }
+
+  int64_t start = host_heap_used;
+  host_panel_clear(TFT_BLACK);
+  tft.fillPolygon(rx.data(), ry.data(), rx.size(), TFT_GREEN);
+
+  HOST_CHECK(memcmp(expect, host_panel, sizeof(expect)) == 0);
+  HOST_CHECK(host_heap_used == start);
+}
+
+int main()
+{
+  srand(3);
+  tft.init();
+
+  // Random outlines, some crossing themselves and some off the screen
+  for (int t = 0; t < 200; t++)
+  {
+    uint16_t n = 3 + random(POLYGON_STACK_CORNERS - 2);
+    std::vector<int32_t> x, y;
+    for (uint16_t i = 0; i < n; i++)
+    {
+      x.push_back(random(HOST_PANEL_SIZE + 40) - 20);
+      y.push_back(random(HOST_PANEL_SIZE + 40) - 20);
+    }
+    compare(x, y, POLYGON_STACK_CORNERS / n + 1 + random(3));
+  }
+
+  // A star with many points, drawn in a viewport
+  std::vector<int32_t> x, y;
+  for (int i = 0; i < 200; i++)
+  {
+    float a = i * 3.14159265f / 100, r = (i & 1) ? 30 : 60;
+    x.push_back(64 + r * cosf(a));
+    y.push_back(64 + r * sinf(a));
+  }
+  tft.setViewport(10, 20, 100, 90, false);
+  compare(x, y, 1);
+  compare(x, y, 3);
+  tft.resetViewport();
+
+  return host_result("par_polygon");
+}
@@ -0,0 +1,84 @@
+// Anti-aliased ellipses: a circle drawn as an ellipse matches fillSmoothCircle(), and the
+// pixels drawn by fillEllipse() and drawEllipse() are covered by the smooth versions, which
+// only add blended pixels next to them. The ellipse is symmetric about its centre lines.
+#include <TFT_eSPI.h>
+#include "host.h"
+
+static TFT_eSPI tft;
+
+static uint16_t ref[HOST_PANEL_SIZE][HOST_PANEL_SIZE];
+
+static const uint16_t black = TFT_BLACK, white = TFT_WHITE;
+
+static uint8_t green(uint16_t c) { return (c >> 5) & 0x3F; }
+
+// Check the smooth shape on the panel against the reference drawn by the integer version
+static void compare(int32_t x, int32_t y, int32_t rx, int32_t ry, bool filled)
+{
+  host_panel_clear(TFT_BLACK);
+  if (filled) tft.fillEllipse(x, y, rx, ry, TFT_WHITE);
+  else tft.drawEllipse(x, y, rx, ry, TFT_WHITE);
+  memcpy(ref, host_panel, sizeof(ref));
+
+  host_panel_clear(TFT_BLACK);
+  if (filled) tft.fillSmoothEllipse(x, y, rx, ry, TFT_WHITE, TFT_BLACK);
+  else tft.drawSmoothEllipse(x, y, rx, ry, TFT_WHITE, TFT_BLACK);
+
+  const int32_t W = tft.width(), H = tft.height();
+  for (int32_t j = 0; j < H; j++)
+    for (int32_t i = 0; i < W; i++)
+    {
+      uint16_t c = host_panel[j][i];
+      if (ref[j][i]) HOST_CHECK(c != black); // Every reference pixel is drawn
+
+      bool nearRef = false, insideRef = filled;
+      for (int32_t dj = -1; dj <= 1; dj++)
+        for (int32_t di = -1; di <= 1; di++)
+        {
+          int32_t u = i + di, v = j + dj;
+          bool on = (u >= 0) && (v >= 0) && (u < W) && (v < H) && ref[v][u];
+          nearRef |= on;
+          insideRef &= on;
+        }
+      if (!nearRef) HOST_CHECK(c == black); // Blended pixels are next to the reference
+      if (insideRef) HOST_CHECK(c == white); // and the inside of a filled one is solid
+
+      // Mirror images about the centre lines, where they are on the screen
+      int32_t mi = 2 * x - i, mj = 2 * y - j;
+      if ((mi >= 0) && (mi < W)) HOST_CHECK(host_panel[j][mi] == c);
+      if ((mj >= 0) && (mj < H)) HOST_CHECK(host_panel[mj][i] == c);
+    }
+}
+
+int main()
+{
+  tft.init();
+  tft.setRotation(0);
+
+  // An ellipse with equal axes is a circle, blends may differ by one level
+  for (int32_t r : { 0, 1, 2, 5, 17, 40 })
+  {
+    host_panel_clear(TFT_BLACK);
+    tft.fillSmoothCircle(60, 70, r, TFT_WHITE, TFT_BLACK);
+    memcpy(ref, host_panel, sizeof(ref));
+
+    host_panel_clear(TFT_BLACK);
+    tft.fillSmoothEllipse(60, 70, r, r, TFT_WHITE, TFT_BLACK);
+    for (int32_t j = 0; j < HOST_PANEL_SIZE; j++)
+      for (int32_t i = 0; i < HOST_PANEL_SIZE; i++)
+        HOST_CHECK(abs(green(host_panel[j][i]) - green(ref[j][i])) <= 1);
+  }
+
+  const int32_t axes[][2] = { { 2, 2 }, { 3, 9 }, { 20, 6 }, { 50, 30 }, { 8, 70 }, { 60, 3 }, { 25, 24 } };
+  for (auto& a : axes)
+  {
+    compare(64, 80, a[0], a[1], true);
+    compare(64, 80, a[0], a[1], false);
+  }
+
+  // Clipped by the screen edges
+  compare(5, 10, 30, 20, true);
+  compare(120, 150, 30, 20, false);
+
+  return host_result("par_smooth_ellipse");
+}
@@ -0,0 +1,250 @@
+// fillCircle(), fillEllipse() and fillRoundRect() draw merged row spans in one transaction.
+// They are compared with the line by line fills they replaced (below, as in the original
+// library) for identical pixels, on the TFT and in a Sprite, and for the bytes sent
+#include <TFT_eSPI.h>
+#include "host.h"
+
+// The fills before the span table, for the TFT or a Sprite
+template <class Base> class OldShapes : public Base {
+ public:
+  using Base::Base;
+
+  void oldFillCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color)
+  {
+    int32_t x = 0;
+    int32_t dx = 1;
+    int32_t dy = r + r;
+    int32_t p = -(r >> 1);
+
+    this->startWrite();
+    this->drawFastHLine(x0 - r, y0, dy + 1, color);
+
+    while (x < r) {
+      if (p >= 0) {
+        this->drawFastHLine(x0 - x, y0 + r, dx, color);
+        this->drawFastHLine(x0 - x, y0 - r, dx, color);
+        dy -= 2;
+        p -= dy;
+        r--;
+      }
+
+      dx += 2;
+      p += dx;
+      x++;
+
+      this->drawFastHLine(x0 - r, y0 + x, dy + 1, color);
+      this->drawFastHLine(x0 - r, y0 - x, dy + 1, color);
+    }
+    this->endWrite();
+  }
+
+  void oldFillCircleHelper(int32_t x0, int32_t y0, int32_t r, uint8_t cornername, int32_t delta, uint32_t color)
+  {
+    int32_t f = 1 - r;
+    int32_t ddF_x = 1;
+    int32_t ddF_y = -r - r;
+    int32_t y = 0;
+
+    delta++;
+
+    while (y < r) {
+      if (f >= 0) {
+        if (cornername & 0x1) this->drawFastHLine(x0 - y, y0 + r, y + y + delta, color);
+        if (cornername & 0x2) this->drawFastHLine(x0 - y, y0 - r, y + y + delta, color);
+        r--;
+        ddF_y += 2;
+        f += ddF_y;
+      }
+
+      y++;
+      ddF_x += 2;
+      f += ddF_x;
+
+      if (cornername & 0x1) this->drawFastHLine(x0 - r, y0 + y, r + r + delta, color);
+      if (cornername & 0x2) this->drawFastHLine(x0 - r, y0 - y, r + r + delta, color);
+    }
+  }
+
+  void oldFillEllipse(int16_t x0, int16_t y0, int32_t rx, int32_t ry, uint16_t color)
+  {
+    if (rx < 2) return;
+    if (ry < 2) return;
+    int32_t x, y;
+    int32_t rx2 = rx * rx;
+    int32_t ry2 = ry * ry;
+    int32_t fx2 = 4 * rx2;
+    int32_t fy2 = 4 * ry2;
+    int32_t s;
+
+    this->startWrite();
+    for (x = 0, y = ry, s = 2 * ry2 + rx2 * (1 - 2 * ry); ry2 * x <= rx2 * y; x++) {
+      this->drawFastHLine(x0 - x, y0 - y, x + x + 1, color);
+      this->drawFastHLine(x0 - x, y0 + y, x + x + 1, color);
+
+      if (s >= 0) {
+        s += fx2 * (1 - y);
+        y--;
+      }
+      s += ry2 * ((4 * x) + 6);
+    }
+
+    for (x = rx, y = 0, s = 2 * rx2 + ry2 * (1 - 2 * rx); rx2 * y <= ry2 * x; y++) {
+      this->drawFastHLine(x0 - x, y0 - y, x + x + 1, color);
+      this->drawFastHLine(x0 - x, y0 + y, x + x + 1, color);
+
+      if (s >= 0) {
+        s += fy2 * (1 - x);
+        x--;
+      }
+      s += rx2 * ((4 * y) + 6);
+    }
+    this->endWrite();
+  }
+
+  void oldFillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color)
+  {
+    this->startWrite();
+    this->fillRect(x, y + r, w, h - r - r, color);
+    oldFillCircleHelper(x + r, y + h - r - 1, r, 1, w - r - r - 1, color);
+    oldFillCircleHelper(x + r, y + r, r, 2, w - r - r - 1, color);
+    this->endWrite();
+  }
+
+  // Draw shape s with the old (true) or new fill
+  void shape(const int32_t* s, bool old)
+  {
+    switch (s[0]) {
+      case 0:
+        if (old) oldFillCircle(s[1], s[2], s[3], s[6]);
+        else this->fillCircle(s[1], s[2], s[3], s[6]);
+        break;
+      case 1:
+        if (old) oldFillEllipse(s[1], s[2], s[3], s[4], s[6]);
+        else this->fillEllipse(s[1], s[2], s[3], s[4], s[6]);
+        break;
+      default:
+        if (old) oldFillRoundRect(s[1], s[2], s[3], s[4], s[5], s[6]);
+        else this->fillRoundRect(s[1], s[2], s[3], s[4], s[5], s[6]);
+        break;
+    }
+  }
+};
+
+static OldShapes<TFT_eSPI> tft;
+static uint16_t expect[HOST_PANEL_SIZE][HOST_PANEL_SIZE];
+
+static int32_t rnd(int32_t lo, int32_t hi) { return lo + random(hi - lo + 1); }
+
+// A random shape: type, x, y, width or radius, height or y radius, corner radius, colour.
+// Round rect corners are at most half the shorter side, as the old fill needs.
+static void randomShape(int32_t* s)
+{
+  s[0] = random(3);
+  s[1] = rnd(-40, 200);
+  s[2] = rnd(-40, 170);
+  s[3] = rnd(s[0] == 2 ? 1 : 0, 90);
+  s[4] = rnd(s[0] == 2 ? 1 : 0, 90);
+  s[5] = rnd(0, (s[3] < s[4] ? s[3] : s[4]) / 2);
+  s[6] = random(0x10000);
+}
+
+static uint32_t busBytes(void)
+{
+  return host_bus.commands + host_bus.data + host_bus.pixels * 2;
+}
+
+// Draw one shape each way on the TFT, check the pixels match and print the bytes sent
+static void measure(const char* name, const int32_t* s)
+{
+  host_panel_clear(TFT_BLACK);
+  tft.shape(s, true);
+  uint32_t oldCommands = host_bus.commands, oldBytes = busBytes();
+  memcpy(expect, host_panel, sizeof(expect));
+
+  host_panel_clear(TFT_BLACK);
+  tft.shape(s, false);
+  HOST_CHECK(memcmp(expect, host_panel, sizeof(expect)) == 0);
+  HOST_CHECK(busBytes() <= oldBytes);
+
+  printf("%-22s %8u %8u %10u %10u\n", name, oldCommands, host_bus.commands, oldBytes, busBytes());
+}
+
+int main()
+{
+  srand(7);
+  tft.init();
+
+  // Random shapes in random viewports and rotations
+  uint32_t oldCommands = 0, newCommands = 0, oldBytes = 0, newBytes = 0;
+  for (int t = 0; t < 3000; t++)
+  {
+    if (t % 100 == 0)
+    {
+      tft.setRotation(random(4));
+      if (random(3)) tft.setViewport(rnd(-10, 80), rnd(-10, 60), rnd(1, 170), rnd(1, 140), random(2));
+      else tft.resetViewport();
+    }
+
+    int32_t s[7];
+    randomShape(s);
+
+    host_panel_clear(TFT_BLACK);
+    tft.shape(s, true);
+    oldCommands += host_bus.commands;
+    oldBytes += busBytes();
+    memcpy(expect, host_panel, sizeof(expect));
+
+    host_panel_clear(TFT_BLACK);
+    tft.shape(s, false);
+    newCommands += host_bus.commands;
+    newBytes += busBytes();
+
+    if (memcmp(expect, host_panel, sizeof(expect)))
+    {
+      HOST_CHECK(!"shape drawn differently");
+      printf("shape %d: %d %d %d %d %d\n", s[0], s[1], s[2], s[3], s[4], s[5]);
+      break;
+    }
+  }
+  HOST_CHECK(newBytes <= oldBytes);
+  tft.resetViewport();
+  tft.setRotation(0);
+
+  // The same shapes in a Sprite, pushed to the TFT to compare
+  OldShapes<TFT_eSprite> spr(&tft);
+  spr.createSprite(120, 150);
+  for (int t = 0; t < 500; t++)
+  {
+    int32_t s[7];
+    randomShape(s);
+    s[1] -= 20; s[2] -= 10;
+
+    host_panel_clear(TFT_BLACK);
+    spr.fillSprite(TFT_BLACK);
+    spr.shape(s, true);
+    spr.pushSprite(0, 0);
+    memcpy(expect, host_panel, sizeof(expect));
+
+    host_panel_clear(TFT_BLACK);
+    spr.fillSprite(TFT_BLACK);
+    spr.shape(s, false);
+    spr.pushSprite(0, 0);
+    HOST_CHECK(memcmp(expect, host_panel, sizeof(expect)) == 0);
+  }
+  spr.deleteSprite();
+
+  printf("                        commands          bus bytes\n");
+  printf("shape                   old      new       old        new\n");
+  printf("%-22s %8u %8u %10u %10u\n", "3000 random", oldCommands, newCommands, oldBytes, newBytes);
+
+  const int32_t circle[7]    = { 0, 64, 80, 50, 0, 0, TFT_RED };
+  const int32_t screen[7]    = { 0, 64, 80, 120, 0, 0, TFT_RED };
+  const int32_t ellipse[7]   = { 1, 64, 80, 60, 30, 0, TFT_RED };
+  const int32_t roundRect[7] = { 2, 4, 10, 120, 140, 12, TFT_RED };
+  measure("circle r=50", circle);
+  measure("circle over screen", screen);
+  measure("ellipse 60x30", ellipse);
+  measure("round rect 120x140", roundRect);
+
+  return host_result("par_spans");
+}
@@ -0,0 +1,71 @@
+// Text width cache: a string measured again is a hit, and a different string of the same
+// length with the same FNV-1a hash must be measured, not given the cached width
+#include <TFT_eSPI.h>
+#include "host.h"
+
+static TFT_eSPI tft;
+
+static void put32(FILE* f, uint32_t x)
+{
+  for (int s = 24; s >= 0; s -= 8) fputc(x >> s, f);
+}
+
+// A vlw font for codes 0x21 to 0x7E whose glyph advances differ from code to code
+static void writeFont(const char* name)
+{
+  FILE* f = fopen(name, "wb");
+  put32(f, 94); put32(f, 11); put32(f, 12); put32(f, 0); put32(f, 9); put32(f, 3);
+  for (uint32_t c = 0x21; c < 0x7F; c++)
+  {
+    put32(f, c); put32(f, 10); put32(f, 4); put32(f, 4 + c % 7); put32(f, 9); put32(f, 0); put32(f, 0);
+  }
+  for (uint32_t i = 0; i < 94 * 4 * 10; i++) fputc(0xFF, f);
+  fclose(f);
+}
+
+static uint32_t fnv1a(const char *s)
+{
+  uint32_t h = 2166136261UL;
+  while (*s) h = (h ^ (uint8_t) *s++) * 16777619UL;
+  return h;
+}
+
+// Pairs of strings with the same length and FNV-1a hash, the second shares an 8 byte prefix
+static const char *collide[][2] = {
+  { "Label: oGmuS", "Label: NaoVs" },
+  { "Speed = jNdpm", "Speed = YrBiS" },
+};
+
+int main()
+{
+  host_fs_root(".");
+  writeFont("widths.vlw");
+
+  tft.init();
+  tft.loadFont("widths", SPIFFS);
+
+  for (auto& pair : collide)
+  {
+    const char *a = pair[0], *b = pair[1];
+    HOST_CHECK(strlen(a) == strlen(b) && fnv1a(a) == fnv1a(b));
+
+    HOST_CHECK(tft.setTextWidthCache(0));
+    int16_t widthA = tft.textWidth(a), widthB = tft.textWidth(b);
+    HOST_CHECK(widthA != widthB);
+
+    HOST_CHECK(tft.setTextWidthCache(16));
+    tft.getTextWidthCacheStats(nullptr, nullptr, true);
+    uint32_t hits, misses;
+    HOST_CHECK(tft.textWidth(a) == widthA);
+    HOST_CHECK(tft.textWidth(a) == widthA);
+    HOST_CHECK(tft.textWidth(b) == widthB);
+    HOST_CHECK(tft.textWidth(b) == widthB);
+    HOST_CHECK(tft.textWidth(a) == widthA);
+    tft.getTextWidthCacheStats(&hits, &misses);
+    HOST_CHECK(hits == 2 && misses == 3);
+  }
+
+  tft.setTextWidthCache(0);
+  tft.unloadFont();
+  return host_result("par_width_cache");
+}
@@ -0,0 +1,69 @@
+// Window cache: setWindow() and drawPixel() skip CASET/PASET for an unchanged window. The
+// cache must be cleared when the TFT window changes some other way, by a window command
+// sent with writecommand() or by init() resetting the TFT.
+#include <TFT_eSPI.h>
+#include "host.h"
+
+static TFT_eSPI tft;
+
+static uint16_t expect[HOST_PANEL_SIZE][HOST_PANEL_SIZE];
+
+static void keepExpected(void) { memcpy(expect, host_panel, sizeof(expect)); }
+static bool matchesExpected(void) { return memcmp(expect, host_panel, sizeof(expect)) == 0; }
+
+// Send a raw window command for the range s to e
+static void rawWindow(uint8_t cmd, uint16_t s, uint16_t e)
+{
+  tft.writecommand(cmd);
+  tft.writedata(s >> 8); tft.writedata(s);
+  tft.writedata(e >> 8); tft.writedata(e);
+}
+
+int main()
+{
+  tft.init();
+  tft.setRotation(0);
+
+  // The same pixels drawn with nothing else in between
+  host_panel_clear(TFT_BLACK);
+  tft.drawPixel(5, 7, TFT_RED);
+  tft.drawPixel(5, 7, TFT_GREEN);
+  tft.drawPixel(9, 7, TFT_BLUE);
+  keepExpected();
+  HOST_CHECK(host_bus.pixels == 3);
+
+  // Raw column and row commands between drawPixel() calls at the same position
+  for (uint8_t cmd : { (uint8_t)TFT_CASET, (uint8_t)TFT_PASET })
+  {
+    host_panel_clear(TFT_BLACK);
+    tft.drawPixel(5, 7, TFT_RED);
+    rawWindow(cmd, 40, 50);
+    tft.drawPixel(5, 7, TFT_GREEN);
+    tft.drawPixel(9, 7, TFT_BLUE);
+    HOST_CHECK(matchesExpected());
+  }
+
+  // Raw commands followed by setAddrWindow() for the window cached before them
+  host_panel_clear(TFT_BLACK);
+  tft.drawPixel(5, 7, TFT_RED);
+  rawWindow(TFT_CASET, 40, 50);
+  rawWindow(TFT_PASET, 60, 70);
+  tft.startWrite();
+  tft.setAddrWindow(5, 7, 1, 1);
+  tft.pushColor(TFT_GREEN);
+  tft.endWrite();
+  tft.drawPixel(9, 7, TFT_BLUE);
+  HOST_CHECK(matchesExpected());
+
+  // A second init() resets the TFT, the next window is sent in full
+  host_panel_clear(TFT_BLACK);
+  tft.drawPixel(5, 7, TFT_RED);
+  tft.init();
+  uint32_t commands = host_bus.commands;
+  tft.drawPixel(5, 7, TFT_GREEN);
+  HOST_CHECK(host_bus.commands - commands == 3); // CASET, PASET and RAMWR
+  tft.drawPixel(9, 7, TFT_BLUE);
+  HOST_CHECK(matchesExpected());
+
+  return host_result("par_window_cache");
+}
@@ -0,0 +1,84 @@
+// pushBandsDMA(): rendering a band overlaps the transfer of the previous band. Compared
+// with rendering each band into one buffer and waiting for it to be sent, on simulated time.
+#include <TFT_eSPI.h>
+#include "host.h"
+
+static TFT_eSPI tft;
+
+static uint32_t renderNs; // Simulated CPU time to render one pixel
+
+static void render(uint16_t* buffer, int32_t x, int32_t y, int32_t w, int32_t lines)
+{
+  for (int32_t j = 0; j < lines; j++)
+    for (int32_t i = 0; i < w; i++)
+    {
+      uint16_t c = (x + i) * 0x0841 ^ (y + j) * 0x1003;
+      *buffer++ = c << 8 | c >> 8;
+    }
+  host_cpu((uint64_t)renderNs * w * lines);
+}
+
+// Render and send each band in turn from a single buffer
+static void serial(int32_t w, int32_t h, int32_t lines)
+{
+  uint16_t* band = (uint16_t*)malloc(w * lines * 2);
+
+  tft.setAddrWindowDMA(0, 0, w, h);
+  for (int32_t y = 0; y < h; y += lines)
+  {
+    int32_t n = (h - y < lines) ? h - y : lines;
+    render(band, 0, y, w, n);
+    tft.pushPixelsDMA(band, w * n);
+    tft.dmaWait();
+  }
+  free(band);
+}
+
+int main()
+{
+  tft.init();
+  HOST_CHECK(tft.initDMA());
+
+  const int32_t w = TFT_WIDTH, h = TFT_HEIGHT, lines = 16;
+  static uint16_t expect[TFT_HEIGHT][TFT_WIDTH];
+
+  printf("%dx%d window, %d line bands, SPI %d MHz\n", w, h, lines, SPI_FREQUENCY / 1000000);
+  printf("render ns/pixel   CPU us   bus us   serial us   banded us   saved\n");
+
+  const uint32_t cost[] = { 25, 100, 400, 800, 1600 };
+  for (uint32_t c : cost)
+  {
+    renderNs = c;
+
+    host_panel_clear();
+    host_dma_reset();
+    uint64_t start = host_time_ns;
+    serial(w, h, lines);
+    uint64_t serialNs = host_time_ns - start;
+    uint64_t busNs = host_dma.busy_ns;
+    HOST_CHECK(host_bus.pixels == (uint32_t)(w * h));
+    for (int32_t y = 0; y < h; y++)
+      for (int32_t x = 0; x < w; x++) expect[y][x] = host_panel[y][x];
+
+    host_panel_clear();
+    host_dma_reset();
+    start = host_time_ns;
+    HOST_CHECK(tft.pushBandsDMA(0, 0, w, h, lines, render));
+    uint64_t bandNs = host_time_ns - start;
+
+    // Same image, and never slower than the slower of CPU and bus
+    HOST_CHECK(host_bus.pixels == (uint32_t)(w * h));
+    for (int32_t y = 0; y < h; y++)
+      for (int32_t x = 0; x < w; x++) HOST_CHECK(host_panel[y][x] == expect[y][x]);
+
+    uint64_t cpuNs = (uint64_t)c * w * h;
+    HOST_CHECK(bandNs < serialNs);
+    HOST_CHECK(bandNs >= (cpuNs > busNs ? cpuNs : busNs));
+
+    printf("%15u %8.0f %8.0f %11.0f %11.0f %6.0f%%\n", c, cpuNs / 1e3, busNs / 1e3,
+           serialNs / 1e3, bandNs / 1e3, 100.0 * (serialNs - bandNs) / serialNs);
+  }
+
+  tft.deInitDMA();
+  return host_result("spi_bench_bands");
+}
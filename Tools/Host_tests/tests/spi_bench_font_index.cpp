@@ -0,0 +1,96 @@
+// getUnicodeIndex(): the ASCII table and binary search give the same glyph as the linear
+// scan they replaced, timed against it for fonts with an increasing number of glyphs
+#include <TFT_eSPI.h>
+#include "host.h"
+
+static TFT_eSPI tft;
+static volatile uint32_t sink; // Keeps the timed lookups
+
+static void put32(std::vector<uint8_t>& v, uint32_t x)
+{
+  for (int s = 24; s >= 0; s -= 8) v.push_back(x >> s);
+}
+
+// A vlw font in memory with empty bitmaps. The codes are ASCII then a spread of higher
+// codes, written out of order with a few duplicates as some font tools produce.
+static std::vector<uint8_t> makeFont(uint16_t count, std::vector<uint16_t>& codes)
+{
+  codes.clear();
+  for (uint16_t c = 0x20; c < 0x7F && codes.size() < count; c++) codes.push_back(c);
+  for (uint32_t c = 0xA0; codes.size() < count; c += 3) codes.push_back(c);
+
+  for (uint16_t i = codes.size() - 1; i > 0; i--) std::swap(codes[i], codes[random(i + 1)]);
+  for (uint16_t i = 0; i < count / 64; i++) codes[random(count)] = codes[random(count)];
+
+  std::vector<uint8_t> v;
+  put32(v, count); put32(v, 11); put32(v, 12); put32(v, 0); put32(v, 9); put32(v, 3);
+  for (uint16_t c : codes)
+  {
+    put32(v, c); put32(v, 0); put32(v, 0); put32(v, 6); put32(v, 0); put32(v, 0); put32(v, 0);
+  }
+  return v;
+}
+
+// The lookup used before the index was added
+static bool linearIndex(uint16_t unicode, uint16_t *index)
+{
+  for (uint16_t i = 0; i < tft.gFont.gCount; i++)
+  {
+    if (tft.gUnicode[i] == unicode)
+    {
+      *index = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+int main()
+{
+  srand(1);
+  printf("glyphs   linear ns/lookup   index ns/lookup   speed up\n");
+
+  const uint16_t counts[] = { 95, 256, 1024, 4096, 16384 };
+  for (uint16_t count : counts)
+  {
+    std::vector<uint16_t> codes;
+    std::vector<uint8_t> font = makeFont(count, codes);
+    tft.loadFont(font.data());
+    HOST_CHECK(tft.gFont.gCount == count);
+
+    // Present and missing codes, ASCII and above
+    std::vector<uint16_t> probe;
+    for (int i = 0; i < 4000; i++) probe.push_back(i & 1 ? codes[random(count)] : random(0x10000));
+
+    for (uint16_t code : probe)
+    {
+      uint16_t a = 0xFFFF, b = 0xFFFF;
+      bool fa = linearIndex(code, &a);
+      bool fb = tft.getUnicodeIndex(code, &b);
+      HOST_CHECK(fa == fb);
+      if (fa) HOST_CHECK(a == b);
+    }
+
+    uint32_t sum = 0;
+    uint16_t index;
+    int reps = 100000 / count + 1;
+
+    uint64_t t = host_micros();
+    for (int r = 0; r < reps; r++)
+      for (uint16_t code : probe) if (linearIndex(code, &index)) sum += index;
+    double linearNs = (host_micros() - t) * 1000.0 / (reps * probe.size());
+
+    reps *= 20;
+    t = host_micros();
+    for (int r = 0; r < reps; r++)
+      for (uint16_t code : probe) if (tft.getUnicodeIndex(code, &index)) sum += index;
+    double indexNs = (host_micros() - t) * 1000.0 / (reps * probe.size());
+
+    sink = sum;
+
+    printf("%6u %18.1f %17.1f %9.0fx\n", count, linearNs, indexNs, linearNs / indexNs);
+    tft.unloadFont();
+  }
+
+  return host_result("spi_bench_font_index");
+}
@@ -0,0 +1,138 @@
+// DMA transaction ring: slots are reused in order, transfers are retired in queue order,
+// completion callbacks see increasing fences and fences still compare across wraparound
+#include <TFT_eSPI.h>
+#include "host.h"
+
+extern uint32_t dmaFenceQueued;
+extern volatile uint32_t dmaFenceComplete;
+
+static TFT_eSPI tft;
+
+static std::vector<uint32_t> doneFence;
+static std::vector<uintptr_t> doneArg;
+
+static void done(uint32_t fence, void* arg)
+{
+  doneFence.push_back(fence);
+  doneArg.push_back((uintptr_t)arg);
+}
+
+static uint16_t wire(uint16_t c) { return c << 8 | c >> 8; } // Colour in SPI byte order
+
+// Queue more transfers than there are slots and check the ring order
+static void ringOrder(void)
+{
+  static uint16_t line[8];
+  const uint32_t count = 3 * DMA_QUEUE_SIZE + 5;
+
+  host_dma_reset();
+  host_dma_log_on = true;
+  doneFence.clear();
+  doneArg.clear();
+
+  uint32_t first = tft.dmaFence() + 1;
+  for (uint32_t i = 0; i < count; i++)
+  {
+    uint32_t fence = tft.pushPixelsDMA(line, 8, done, (void*)(uintptr_t)i);
+    HOST_CHECK(fence == first + i);
+    HOST_CHECK(tft.spiBusyCheck <= DMA_QUEUE_SIZE);
+  }
+  tft.dmaWait();
+  host_dma_log_on = false;
+
+  HOST_CHECK(tft.spiBusyCheck == 0);
+  HOST_CHECK(host_dma.max_depth == DMA_QUEUE_SIZE);
+  HOST_CHECK(host_dma_log.size() == count);
+
+  // Each slot is used once per trip round the ring, in the same order every time
+  for (uint32_t i = 0; i < count; i++)
+  {
+    if (i >= DMA_QUEUE_SIZE) HOST_CHECK(host_dma_log[i] == host_dma_log[i - DMA_QUEUE_SIZE]);
+    for (uint32_t j = (i >= DMA_QUEUE_SIZE) ? i - DMA_QUEUE_SIZE + 1 : 0; j < i; j++)
+      HOST_CHECK(host_dma_log[i] != host_dma_log[j]);
+  }
+
+  // Callbacks run once per transfer, in queue order
+  HOST_CHECK(doneFence.size() == count);
+  for (uint32_t i = 0; i < doneFence.size(); i++)
+  {
+    HOST_CHECK(doneFence[i] == first + i);
+    HOST_CHECK(doneArg[i] == i);
+  }
+}
+
+// dmaWaitFence() retires transfers up to the fence and leaves the rest queued
+static void waitFence(void)
+{
+  static uint16_t line[64];
+  uint32_t fence[6];
+
+  for (int i = 0; i < 6; i++) fence[i] = tft.pushPixelsDMA(line, 64);
+
+  tft.dmaWaitFence(fence[2]);
+  HOST_CHECK(tft.dmaFenceDone(fence[2]));
+  HOST_CHECK(!tft.dmaFenceDone(fence[3]));
+  HOST_CHECK(tft.spiBusyCheck == 3);
+
+  tft.dmaWait();
+  HOST_CHECK(tft.dmaFenceDone(fence[5]));
+  HOST_CHECK(tft.spiBusyCheck == 0);
+}
+
+// Fences are compared with a signed difference so the order holds when the count wraps
+static void fenceWrap(void)
+{
+  static uint16_t line[64];
+
+  tft.deInitDMA();
+  dmaFenceQueued = 0xFFFFFFFF - 5;
+  HOST_CHECK(tft.initDMA());
+
+  uint32_t fence[10];
+  for (int i = 0; i < 10; i++) fence[i] = tft.pushPixelsDMA(line, 64);
+
+  HOST_CHECK(fence[4] == 0xFFFFFFFF);
+  HOST_CHECK(fence[5] == 0);
+  HOST_CHECK(tft.dmaFenceDone(fence[0] - 1));
+
+  for (int i = 0; i < 10; i++)
+  {
+    tft.dmaWaitFence(fence[i]);
+    HOST_CHECK(tft.dmaFenceDone(fence[i]));
+    if (i < 9) HOST_CHECK(!tft.dmaFenceDone(fence[i + 1]));
+  }
+  HOST_CHECK(tft.spiBusyCheck == 0);
+}
+
+// Window commands and pixels share the ring, images must reach the display in order
+static void imagesThroughRing(void)
+{
+  static uint16_t image[16][8 * 8];
+
+  host_panel_clear();
+
+  for (int i = 0; i < 16; i++)
+    for (int p = 0; p < 64; p++) image[i][p] = wire(i * 0x1111 + p);
+
+  // Each image takes up to 6 slots, so the ring wraps several times
+  for (int i = 0; i < 16; i++) tft.pushImageDMA((i % 4) * 20, (i / 4) * 20, 8, 8, image[i]);
+  tft.dmaWait();
+
+  for (int i = 0; i < 16; i++)
+    for (int p = 0; p < 64; p++)
+      HOST_CHECK(host_panel[(i / 4) * 20 + p / 8][(i % 4) * 20 + p % 8] == (uint16_t)(i * 0x1111 + p));
+}
+
+int main()
+{
+  tft.init();
+  HOST_CHECK(tft.initDMA());
+
+  ringOrder();
+  waitFence();
+  fenceWrap();
+  imagesThroughRing();
+
+  tft.deInitDMA();
+  return host_result("spi_dma_ring");
+}
@@ -0,0 +1,87 @@
+// Fonts parked in other handles by selectFont() are freed by unloadAllFonts() and when a
+// sprite is deleted: metrics, cached glyphs and font files
+#include <TFT_eSPI.h>
+#include "host.h"
+
+static TFT_eSPI tft;
+
+static void put32(FILE* f, uint32_t x)
+{
+  for (int s = 24; s >= 0; s -= 8) fputc(x >> s, f);
+}
+
+// Write a vlw font file of 8x10 glyphs for codes 0x20 to 0x7E
+static void writeFont(const char* name, uint8_t alpha)
+{
+  FILE* f = fopen(name, "wb");
+  put32(f, 95); put32(f, 11); put32(f, 12); put32(f, 0); put32(f, 9); put32(f, 3);
+  for (uint32_t c = 0x20; c < 0x7F; c++)
+  {
+    put32(f, c); put32(f, 10); put32(f, 8); put32(f, 9); put32(f, 9); put32(f, 0); put32(f, 0);
+  }
+  for (uint32_t i = 0; i < 95 * 80; i++) fputc(alpha ^ i, f);
+  fclose(f);
+}
+
+// Load a font file in every handle and draw with each so their glyph caches fill
+static void loadAll(TFT_eSPI& gfx)
+{
+  for (uint8_t h = 0; h < SMOOTH_FONT_SLOTS; h++)
+  {
+    char name[8];
+    sprintf(name, "font_%u", h);
+    gfx.selectFont(h);
+    gfx.loadFont(name, SPIFFS);
+    gfx.drawString("Parked fonts", 0, 10 * h);
+  }
+  gfx.selectFont(0);
+  HOST_CHECK(host_files_open == SMOOTH_FONT_SLOTS);
+}
+
+int main()
+{
+  host_fs_root(".");
+  for (uint8_t h = 0; h < SMOOTH_FONT_SLOTS; h++)
+  {
+    char name[12];
+    sprintf(name, "font_%u.vlw", h);
+    writeFont(name, 0x11 + h * 0x5A);
+  }
+
+  tft.init();
+
+  // Leave the first use of the heap and file functions out of the count
+  tft.loadFont("font_0", SPIFFS);
+  tft.unloadFont();
+
+  int64_t start = host_heap_used;
+
+  loadAll(tft);
+  tft.unloadAllFonts();
+
+  HOST_CHECK(tft.getFontHandle() == 0);
+  for (uint8_t h = 0; h < SMOOTH_FONT_SLOTS; h++)
+  {
+    tft.selectFont(h);
+    HOST_CHECK(!tft.fontLoaded);
+  }
+  HOST_CHECK(host_files_open == 0);
+  HOST_CHECK(host_heap_used == start);
+
+  // The handles can be used again
+  loadAll(tft);
+  tft.unloadAllFonts();
+  HOST_CHECK(host_files_open == 0);
+  HOST_CHECK(host_heap_used == start);
+
+  // Deleting a sprite frees the fonts in all its handles
+  TFT_eSprite* spr = new TFT_eSprite(&tft);
+  spr->createSprite(100, 40);
+  loadAll(*spr);
+  delete spr;
+
+  HOST_CHECK(host_files_open == 0);
+  HOST_CHECK(host_heap_used == start);
+
+  return host_result("spi_font_slots");
+}
@@ -0,0 +1,67 @@
+// pushPixels() register transfers: the pixels left after the full blocks are loaded into
+// the SPI data registers W0-W15 a word at a time, and no word past the last pixel is read
+#include <TFT_eSPI.h>
+#include "host.h"
+
+static TFT_eSPI tft;
+
+static const uint32_t sentinel = 0xA5A5A5A5;
+static const uint16_t marker = 0xDEAD; // Pixels after the end of the image
+
+static volatile uint32_t* dataReg(uint8_t w)
+{
+  return (volatile uint32_t*)(SPI_W0_REG(SPI_PORT) + 4 * w);
+}
+
+// Push len pixels, which must all be in the last (partial) block, and check the registers
+static void pushTail(uint32_t len, bool swap)
+{
+  std::vector<uint16_t> image(len + 4, marker);
+  for (uint32_t i = 0; i < len; i++) image[i] = 0x1000 * (len & 0xF) + i;
+
+  for (uint8_t w = 0; w < 16; w++) *dataReg(w) = sentinel;
+
+  tft.setSwapBytes(swap);
+  tft.startWrite();
+  tft.pushPixels(image.data(), len);
+  tft.endWrite();
+
+  HOST_CHECK(READ_PERI_REG(SPI_MOSI_DLEN_REG(SPI_PORT)) == len * 16 - 1);
+
+  // Each word holds two pixels, the first in the low half. When the length is odd the high
+  // half of the last word is not sent, so it is not compared
+  const uint8_t* p = (const uint8_t*)image.data();
+  uint32_t words = (len + 1) / 2;
+  for (uint32_t k = 0; k < words; k++)
+  {
+    uint32_t expect = swap ? ((uint32_t)p[4 * k] << 8 | p[4 * k + 1] | (uint32_t)p[4 * k + 2] << 24 | (uint32_t)p[4 * k + 3] << 16)
+                           : ((const uint32_t*)p)[k];
+    uint32_t mask = (2 * k + 1 < len) ? 0xFFFFFFFF : 0x0000FFFF;
+    HOST_CHECK((*dataReg(k) & mask) == (expect & mask));
+  }
+  if (words < 16) HOST_CHECK(*dataReg(words) == sentinel);
+}
+
+int main()
+{
+  tft.init();
+
+  // Without byte swapping the last block is under 32 pixels, with swapping under 16
+  for (uint32_t len = 1; len < 32; len++) pushTail(len, false);
+  for (uint32_t len = 1; len < 16; len++) pushTail(len, true);
+
+  // The over-read was of a whole word, past an exactly sized heap image
+  for (uint32_t len = 2; len < 32; len += 2)
+  {
+    uint16_t* image = (uint16_t*)malloc(len * 2);
+    for (uint32_t i = 0; i < len; i++) image[i] = i;
+    tft.setSwapBytes(len & 2);
+    tft.startWrite();
+    tft.pushPixels(image, len);
+    tft.endWrite();
+    free(image);
+  }
+
+  tft.setSwapBytes(false);
+  return host_result("spi_push_tail");
+}
@@ -0,0 +1,108 @@
+// pushSpriteDMA() sends 16 bit sprite memory as it is. The display must match a copy of
+// the sprite in native byte order pushed with setSwapBytes(true), clipped or not, and the
+// sprite must be left unchanged.
+#include <TFT_eSPI.h>
+#include "host.h"
+
+static TFT_eSPI tft;
+static TFT_eSprite spr(&tft);
+
+static uint32_t doneCount;
+static void done(uint32_t, void*) { doneCount++; }
+
+static void drawSprite(int32_t w, int32_t h)
+{
+  spr.createSprite(w, h);
+  spr.fillSprite(TFT_NAVY);
+  for (int i = 0; i < 40; i++)
+    spr.drawLine(random(w), random(h), random(w), random(h), random(0x10000));
+  spr.fillRect(2, 2, w / 3, h / 3, TFT_ORANGE);
+  spr.setTextColor(TFT_WHITE, TFT_BLACK);
+  spr.drawString("DMA", 4, h / 2, 1);
+}
+
+// Compare pushSpriteDMA() with the byte swapping pushImageDMA() path at x, y
+static void compare(int32_t x, int32_t y)
+{
+  int32_t w = spr.width(), h = spr.height();
+  uint16_t* img = (uint16_t*)spr.getPointer();
+
+  std::vector<uint16_t> before(img, img + w * h);
+  std::vector<uint16_t> native(w * h);
+  for (int32_t i = 0; i < w * h; i++) native[i] = img[i] << 8 | img[i] >> 8;
+
+  static uint16_t expect[HOST_PANEL_SIZE][HOST_PANEL_SIZE];
+  host_panel_clear(TFT_MAGENTA);
+  tft.setSwapBytes(true);
+  tft.pushImageDMA(x, y, w, h, native.data());
+  tft.dmaWait();
+  tft.setSwapBytes(false);
+  memcpy(expect, host_panel, sizeof(expect));
+  uint32_t expectPixels = host_bus.pixels;
+
+  host_panel_clear(TFT_MAGENTA);
+  host_dma_reset();
+  host_dma_log_on = true;
+  doneCount = 0;
+  uint32_t fence = spr.pushSpriteDMA(x, y, done);
+  tft.dmaWait();
+  host_dma_log_on = false;
+
+  HOST_CHECK(memcmp(expect, host_panel, sizeof(expect)) == 0);
+  HOST_CHECK(host_bus.pixels == expectPixels);
+  HOST_CHECK(tft.dmaFenceDone(fence));
+
+  // Nothing visible, nothing sent
+  if (expectPixels == 0)
+  {
+    HOST_CHECK(host_dma.queued == 0);
+    HOST_CHECK(doneCount == 0);
+    return;
+  }
+  HOST_CHECK(doneCount == 1);
+
+  // Pixels are read from the sprite itself, which is not changed
+  for (const spi_transaction_t* t : host_dma_log)
+  {
+    if (t->flags & SPI_TRANS_USE_TXDATA) continue;
+    const uint16_t* p = (const uint16_t*)t->tx_buffer;
+    HOST_CHECK(p >= img && p + t->length / 16 <= img + w * h);
+  }
+  HOST_CHECK(memcmp(before.data(), img, w * h * 2) == 0);
+}
+
+int main()
+{
+  tft.init();
+  HOST_CHECK(tft.initDMA());
+  tft.setRotation(0);
+
+  spr.setColorDepth(16);
+  drawSprite(40, 30);
+
+  const int32_t W = tft.width(), H = tft.height();
+  const int32_t pos[][2] = {
+    {  10,  20 }, {   0,   0 }, { W - 40, H - 30 },   // Whole sprite
+    { -15,  20 }, {  10, -12 }, { -15, -12 },         // Clipped left, top, corner
+    { W - 25, 40 }, { 30, H - 7 }, { W - 1, H - 1 },  // Clipped right, bottom, one pixel
+    { -39, -29 }, { W, 0 }, { 0, -30 },               // One pixel or nothing visible
+  };
+
+  for (auto& p : pos) compare(p[0], p[1]);
+
+  // Clipped by a viewport
+  tft.setViewport(20, 30, 60, 50, false);
+  for (auto& p : pos) compare(p[0] + 30, p[1] + 40);
+  compare(5, 5);
+  tft.resetViewport();
+
+  // Widths with partial rows on each side
+  spr.deleteSprite();
+  drawSprite(7, 33);
+  compare(-3, 5);
+  compare(W - 4, H - 20);
+
+  spr.deleteSprite();
+  tft.deInitDMA();
+  return host_result("spi_sprite_dma");
+}
@@ -65,4 +65,48 @@
 // Transactions are automatically enabled by the library for an ESP32 (to use HAL mutex)
 // so changing it here has no effect
 
-//#define SUPPORT_TRANSACTIONS
\ No newline at end of file
+//#define SUPPORT_TRANSACTIONS
+
+
+// The ESP32 can queue several DMA transfers (pushImageDMA or pushPixelsDMA) so the
+// sketch does not have to wait for each one to finish. Default is 12 queue slots, a
+// pushImageDMA uses 6 of them (5 queued window commands and the image itself).
+
+//#define DMA_QUEUE_SIZE 12
+
+// When DMA is enabled, solid fills of at least DMA_FILL_MIN pixels (e.g. fillScreen and
+// large fillRect) are sent by DMA from a buffer of DMA_FILL_BUFFER pixels. The DMA fill
+// returns without waiting if the sketch has called startWrite() and the transfers fit in
+// the queue, e.g. DMA_QUEUE_SIZE 10 lets a 128x160 screen fill return at once.
+
+//#define DMA_FILL_MIN 512
+//#define DMA_FILL_BUFFER 2048
+
+// 18 bit colour SPI displays (e.g. ILI9488) expand DMA pixels to 3 bytes in two bounce
+// buffers of DMA_BOUNCE_PIXELS each, one is filled while the other is sent.
+
+//#define DMA_BOUNCE_PIXELS 1024
+
+// ESP32 8 bit parallel displays can use DMA through the I2S peripheral in LCD mode if
+// TFT_PARALLEL_DMA is defined. This has not been tested on hardware yet. The WR strobe
+// rate is about 80MHz / (2 * TFT_I2S_CLK_DIV). Default is 4 (10MHz), increase for slow
+// displays.
+
+//#define TFT_PARALLEL_DMA
+//#define TFT_I2S_CLK_DIV 4
+
+// Smooth font glyph bitmaps read from SPIFFS or SD are kept in a least recently used
+// cache of SMOOTH_GLYPH_CACHE bytes (PSRAM if available) so redrawn characters are not
+// read from the file again. Set to 0 to disable the cache.
+
+//#define SMOOTH_GLYPH_CACHE 8192
+
+// Number of smooth fonts that can be loaded at once, selectFont(handle) switches
+// between them without reloading the font metrics.
+
+//#define SMOOTH_FONT_SLOTS 2
+
+// Smooth font strings drawn with a background colour are rendered into a buffer of up to
+// SMOOTH_STRIP_PIXELS pixels, taller strings are sent in bands of rows.
+
+//#define SMOOTH_STRIP_PIXELS 4096